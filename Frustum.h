@@ -15,6 +15,10 @@
  
  #include "fixedvector.h"
  
+ #pragma warning(disable:4995)
+ #include <xmmintrin.h>
+ #pragma warning(default:4995)
+ 
  #define FRUSTUM_MAXPLANES   12
  #define FRUSTUM_P_LEFT      (1<<0)
  #define FRUSTUM_P_RIGHT     (1<<1)
@@ -27,7 +31,28 @@
  #define FRUSTUM_P_ALL       (FRUSTUM_P_LRTB|FRUSTUM_P_NEAR|FRUSTUM_P_FAR)
  
  #define FRUSTUM_SAFE        (FRUSTUM_MAXPLANES*4)
+ #define FRUSTUM_NO_PLANE    u32(-1)
  typedef svector<Fvector,FRUSTUM_SAFE>       sPoly;
+ 
+ // four boxes in SoA layout (center/half-size), fed to CFrustum::testAABB_x4
+ struct  sAABB_x4
+ {
+     __m128          cx,cy,cz;
+     __m128          ex,ey,ez;
+ 
+     IC void         set                 (u32 i, const Fvector& c, const Fvector& e)
+     {
+         VERIFY      (i<4);
+         cx.m128_f32[i]  = c.x;  cy.m128_f32[i]  = c.y;  cz.m128_f32[i]  = c.z;
+         ex.m128_f32[i]  = e.x;  ey.m128_f32[i]  = e.y;  ez.m128_f32[i]  = e.z;
+     }
+     IC void         set                 (u32 i, const Fbox& B)
+     {
+         Fvector     c,e;
+         B.get_CD    (c,e);
+         set         (i,c,e);
+     }
+ };
  ENGINE_API      extern  u32 frustum_aabb_remap[8][6];
  
  class ENGINE_API    CFrustum
@@ -57,6 +82,18 @@
  
          return          fcvPartial;
      }
+ 
+     // same as above for the plane with index 'p', returns 'true' if the box is fully outside
+     // 'test_mask' loses the bit of the plane when box is fully inside it
+     IC BOOL             AABB_RejectPlane    (u32 p, const float* mM, u32& test_mask) const
+     {
+         u32     bit     = 1<<p;
+         switch  (AABB_OverlapPlane(planes[p],mM)) {
+             case fcvNone:   return  TRUE;
+             case fcvFully:  test_mask &= ~bit;  break;
+         }
+         return          FALSE;
+     }
  public:
      IC void         _clear              ()              { p_count=0; }
      void            _add                (Fplane &P);
@@ -78,6 +115,63 @@
      EFC_Visible     testSphere          (Fvector& c, float r, u32& test_mask)                   const;
      BOOL            testSphere_dirty    (Fvector& c, float r)                                   const;
      EFC_Visible     testAABB            (const float* mM, u32& test_mask)                       const;
+ 
+     // plane coherency: 'plane_cache' holds the plane which rejected the object last time (or FRUSTUM_NO_PLANE),
+     // it is tested first and updated when some other plane rejects the box
+     IC EFC_Visible  testAABB_coherent   (const float* mM, u32& test_mask, u32& plane_cache)     const
+     {
+         if ((plane_cache<u32(p_count)) && (test_mask&(1<<plane_cache))) {
+             if (AABB_RejectPlane(plane_cache,mM,test_mask))    return fcvNone;
+         }
+ 
+         for (u32 p=0, bit=1; p<u32(p_count); ++p, bit<<=1) {
+             if ((p==plane_cache) || !(test_mask&bit))   continue;
+             if (AABB_RejectPlane(p,mM,test_mask)) {
+                 plane_cache = p;
+                 return     fcvNone;
+             }
+         }
+ 
+         return          test_mask ? fcvPartial : fcvFully;
+     }
+ 
+     // tests four boxes against all planes in 'test_mask' at once
+     // 'result_mask[i]' receives the remaining planes to test for the children of the box 'i' (parent mask for hierarchical culling),
+     // return value has bit 'i' set if the box 'i' is (at least partially) visible
+     IC u32          testAABB_x4         (const sAABB_x4& B, u32 test_mask, u32 result_mask[4]) const
+     {
+         __m128      outside     = _mm_setzero_ps();
+         __m128      zero        = _mm_setzero_ps();
+         result_mask[0] = result_mask[1] = result_mask[2] = result_mask[3] = test_mask;
+ 
+         for (u32 p=0, bit=1; p<u32(p_count); ++p, bit<<=1) {
+             if (!(test_mask&bit))   continue;
+ 
+             const fplane&   P   = planes[p];
+             __m128  nx      = _mm_set1_ps(P.n.x);
+             __m128  ny      = _mm_set1_ps(P.n.y);
+             __m128  nz      = _mm_set1_ps(P.n.z);
+ 
+             // signed distance of the centers and projected radius of the boxes
+             __m128  dist    = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx,B.cx),_mm_mul_ps(ny,B.cy)),_mm_add_ps(_mm_mul_ps(nz,B.cz),_mm_set1_ps(P.d)));
+             __m128  radius  = _mm_add_ps(_mm_add_ps(
+                 _mm_mul_ps(_mm_set1_ps(_abs(P.n.x)),B.ex),
+                 _mm_mul_ps(_mm_set1_ps(_abs(P.n.y)),B.ey)),
+                 _mm_mul_ps(_mm_set1_ps(_abs(P.n.z)),B.ez));
+ 
+             outside         = _mm_or_ps(outside,_mm_cmpgt_ps(_mm_sub_ps(dist,radius),zero));
+             int     inside  = _mm_movemask_ps(_mm_cmple_ps(_mm_add_ps(dist,radius),zero));
+             if (inside&1)   result_mask[0]  &= ~bit;
+             if (inside&2)   result_mask[1]  &= ~bit;
+             if (inside&4)   result_mask[2]  &= ~bit;
+             if (inside&8)   result_mask[3]  &= ~bit;
+ 
+             if (0xf==_mm_movemask_ps(outside))
+                 return     0;
+         }
+ 
+         return          u32(~_mm_movemask_ps(outside)) & 0xf;
+     }
      EFC_Visible     testSAABB           (Fvector& c, float r, const float* mM, u32& test_mask)  const;
      BOOL            testPolyInside_dirty(Fvector* p, int count)                                 const;
  
@@ -65,8 +65,9 @@
          float                   node_radius;    // Cached node bounds for TBV optimization
          ISpatial_NODE*          node_ptr;       // Cached parent node for "empty-members" optimization
          IRender_Sector*         sector;
+         u32                     cull_plane;     // Last frustum plane which rejected the object (FRUSTUM_NO_PLANE if none)
  
-         _spatial() : type(0)    {}              // safe way to enhure type is zero before any contstructors takes place
+         _spatial() : type(0), cull_plane(u32(-1))   {}              // safe way to enhure type is zero before any contstructors takes place
      }                           spatial;
  public:
      BOOL                        spatial_inside      ();
@@ -168,11 +169,14 @@
      void                            q_box           (xr_vector<ISpatial*>& R, u32 _o, u32 _mask, const Fvector&     _center, const Fvector& _size);
      void                            q_sphere        (xr_vector<ISpatial*>& R, u32 _o, u32 _mask, const Fvector&     _center, const float _radius);
      void                            q_frustum       (xr_vector<ISpatial*>& R, u32 _o, u32 _mask, const CFrustum&    _frustum);
+     IC void                         q_frustum_coherent(xr_vector<ISpatial*>& R, u32 _o, u32 _mask, const CFrustum&  _frustum);
  };
  
  ENGINE_API extern ISpatial_DB*      g_SpatialSpace;
  
  #pragma pack(pop)
+ 
+ #include "ISpatial_q_frustum.h"
 
 
 
@@ -0,0 +1,105 @@
+ #pragma once
+ 
+ // Hierarchical frustum query with plane coherency:
+ //  - every node passes down only the planes its box still intersects
+ //  - children of a node are tested four at a time (CFrustum::testAABB_x4)
+ //  - every object remembers the plane which rejected it last time and tries it first
+ 
+ class ISpatial_frustum_walker
+ {
+ public:
+     xr_vector<ISpatial*>*       R;
+     const CFrustum*             F;
+     u32                         mask;
+     u32                         options;
+ public:
+     ISpatial_frustum_walker     (xr_vector<ISpatial*>* _R, const CFrustum* _F, u32 _mask, u32 _o) : R(_R), F(_F), mask(_mask), options(_o) {}
+ 
+     IC static void  offset      (Fvector& dest, const Fvector& center, u32 octant, float radius)
+     {
+         dest.x      = center.x + ((octant&1) ? radius : -radius);
+         dest.y      = center.y + ((octant&2) ? radius : -radius);
+         dest.z      = center.z + ((octant&4) ? radius : -radius);
+     }
+ 
+     // returns 'true' when the query has to stop (O_ONLYFIRST)
+     bool            items       (ISpatial_NODE* N, u32 fmask)
+     {
+         xr_vector<ISpatial*>::iterator  I = N->items.begin();
+         xr_vector<ISpatial*>::iterator  E = N->items.end();
+         for ( ; I != E; ++I) {
+             ISpatial*       S       = *I;
+             if (0==(S->spatial.type&mask))  continue;
+ 
+             Fvector&        C       = S->spatial.center;
+             float           r       = S->spatial.radius;
+             Fbox            B;
+             B.set           (C.x-r,C.y-r,C.z-r,C.x+r,C.y+r,C.z+r);
+ 
+             u32             tmask   = fmask;
+             if (fcvNone==F->testAABB_coherent(B.data(),tmask,S->spatial.cull_plane))
+                 continue;
+ 
+             R->push_back    (S);
+             if (options&ISpatial_DB::O_ONLYFIRST)
+                 return      (true);
+         }
+         return              (false);
+     }
+ 
+     bool            walk        (ISpatial_NODE* N, const Fvector& n_C, float n_R, u32 fmask)
+     {
+         if (items(N,fmask))
+             return          (true);
+ 
+         // node boxes are loose (twice the cell size), so children get radius n_R/2 and box half-size n_R
+         float               c_R     = n_R/2;
+         ISpatial_NODE*      batch   [8];
+         Fvector             centers [8];
+         u32                 count   = 0;
+         for (u32 octant=0; octant<8; ++octant) {
+             if (!N->children[octant])   continue;
+             batch[count]    = N->children[octant];
+             offset          (centers[count],n_C,octant,c_R);
+             ++count;
+         }
+ 
+         Fvector             e;
+         e.set               (n_R,n_R,n_R);
+         for (u32 base=0; base<count; base+=4) {
+             u32             n       = _min(count-base,u32(4));
+             sAABB_x4        B;
+             for (u32 i=0; i<4; ++i)
+                 B.set       (i,centers[base + (i<n ? i : 0)],e);
+ 
+             u32             masks   [4];
+             u32             visible = F->testAABB_x4(B,fmask,masks);
+             for (u32 i=0; i<n; ++i) {
+                 if (!(visible&(1<<i)))  continue;
+                 if (walk(batch[base+i],centers[base+i],c_R,masks[i]))
+                     return  (true);
+             }
+         }
+         return              (false);
+     }
+ };
+ 
+ IC void ISpatial_DB::q_frustum_coherent (xr_vector<ISpatial*>& R, u32 _o, u32 _mask, const CFrustum& _frustum)
+ {
+     cs.Enter                ();
+     q_result                = &R;
+     q_result->clear_not_free();
+ 
+     ISpatial_frustum_walker W(q_result,&_frustum,_mask,_o);
+     Fbox                    B;
+     B.set                   (m_center.x-2*m_bounds,m_center.y-2*m_bounds,m_center.z-2*m_bounds,m_center.x+2*m_bounds,m_center.y+2*m_bounds,m_center.z+2*m_bounds);
+     u32                     fmask = _frustum.getMask();
+     if (fcvNone!=_frustum.testAABB(B.data(),fmask))
+         W.walk              (m_root,m_center,m_bounds,fmask);
+ 
+     cs.Leave                ();
+ }
+
+
+
+
@@ -8,6 +8,112 @@
      LOCKFLAGS_APPEND    = D3DLOCK_NOOVERWRITE
  };
  
+ // Multi-producer ring allocation over a block of memory (locked dynamic stream or plain system memory)
+ // - producers reserve ranges from any thread with a single CAS on the head
+ // - ranges never straddle the end of the block, the gap is skipped instead
+ // - render thread calls 'fence' once per frame, ranges of the frame are reused after R_RING_FRAMES fences
+ // - every successful 'reserve' must be followed by 'commit' once the range is written, 'close' waits for them
+ // - 'reset' forgets all ranges, 'open' publishes the (possibly moved) block and keeps the offsets,
+ //   so a ring lives across frames while its memory is relocked every frame
+ // Offsets are virtual (monotonic 64-bit, they never wrap), so any block size works.
+ #define R_RING_FRAMES   3
+ 
+ class _RingAllocator
+ {
+ private:
+     u8* volatile                m_base;
+     u32                         m_size;
+     volatile LONGLONG           m_head;                     // virtual offset of the next free byte
+     volatile LONGLONG           m_tail;                     // virtual offset of the oldest byte still in use
+     u64                         m_fences    [R_RING_FRAMES];
+     u32                         m_frame;
+     volatile LONG               m_writers;                  // reserved ranges not committed yet
+ private:
+     IC u64                      _head           () const                    { return u64(InterlockedCompareExchange64((volatile LONGLONG*)&m_head,0,0)); }
+     IC u64                      _tail           () const                    { return u64(InterlockedCompareExchange64((volatile LONGLONG*)&m_tail,0,0)); }
+ public:
+     _RingAllocator              ()                                          { m_base = NULL; m_writers = 0; reset(0); }
+ 
+     // render thread, while closed: forgets every range
+     IC void                     reset           (u32 size)
+     {
+         VERIFY                  (!m_base);
+         m_size                  = size;
+         InterlockedExchange64   (&m_head,0);
+         InterlockedExchange64   (&m_tail,0);
+         m_frame                 = 0;
+         for (u32 i=0; i<R_RING_FRAMES; ++i)
+             m_fences[i]         = 0;
+     }
+     // render thread, while closed: publishes the block of 'size()' bytes, producers may reserve from now on
+     IC void                     open            (void* base)
+     {
+         VERIFY                  (!m_base && base && m_size);
+         InterlockedExchangePointer  ((PVOID volatile*)&m_base,base);
+     }
+     // refuses new reservations, then waits until every reserved range is committed
+     IC void                     close           ()
+     {
+         InterlockedExchangePointer  ((PVOID volatile*)&m_base,NULL);
+         while (m_writers)
+             Sleep               (0);
+     }
+     IC bool                     opened          () const                    { return !!m_base;                  }
+     IC u8*                      base            () const                    { return m_base;                    }
+     IC u32                      size            () const                    { return m_size;                    }
+     IC u64                      head            () const                    { return _head();                   }
+     IC u32                      used            () const                    { return u32(_head() - _tail());    }
+ 
+     // returns NULL if the ring is full or closed, 'offset' receives physical offset in bytes,
+     // aligned to 'align' from the block start (e.g. vertex stride)
+     IC void*                    reserve         (u32 bytes, u32 align, u32& offset)
+     {
+         InterlockedIncrement    (&m_writers);
+         u8*                     base    = m_base;
+         if (!base) {
+             InterlockedDecrement(&m_writers);
+             return              (NULL);
+         }
+         VERIFY                  (bytes && (bytes <= m_size) && align);
+         for (;;) {
+             u64                 head    = _head();
+             u32                 phys    = u32(head % m_size);
+             u32                 aligned = ((phys + align - 1) / align) * align;
+             u64                 start;
+             if (aligned + bytes > m_size) {
+                 start           = head + (m_size - phys);   // skip the gap at the end of the block
+                 phys            = 0;
+             }
+             else {
+                 start           = head + (aligned - phys);
+                 phys            = aligned;
+             }
+             u64                 end     = start + bytes;
+             if (end - _tail() > m_size) {
+                 InterlockedDecrement(&m_writers);
+                 return          (NULL);
+             }
+             if (LONGLONG(head) == InterlockedCompareExchange64(&m_head,LONGLONG(end),LONGLONG(head))) {
+                 offset          = phys;
+                 return          (base + phys);
+             }
+         }
+     }
+ 
+     // the range returned by 'reserve' is written
+     IC void                     commit          ()                          { InterlockedDecrement(&m_writers); }
+ 
+     // render thread only: marks the end of the frame's ranges and retires the oldest frame
+     IC void                     fence           ()
+     {
+         u32                     slot    = m_frame % R_RING_FRAMES;
+         if (m_frame >= R_RING_FRAMES)
+             InterlockedExchange64   (&m_tail,LONGLONG(m_fences[slot]));
+         m_fences[slot]          = _head();
+         ++m_frame;
+     }
+ };
+ 
  class ENGINE_API _VertexStream
  {
  private :
@@ -27,6 +133,7 @@
          mSize       = 0;
          mPosition   = 0;
          mDiscardID  = 0;
+         ring_VB     = NULL;
  #ifdef DEBUG
          dbg_lock    = 0;
  #endif
@@ -44,6 +151,35 @@
      void*                       Lock            ( u32 vl_Count, u32 Stride, u32& vOffset );
      void                        Unlock          ( u32 Count, u32 Stride);
  
+     // Shared ring: its own dynamic buffer, locked once per frame with no-overwrite between ring_Begin and ring_End.
+     // Worker threads reserve ranges through 'ring' with 'align' of the vertex stride and commit them,
+     // a range is drawn with base vertex offset/stride and is reused R_RING_FRAMES frames later.
+     // The buffer is in the default pool : ring_Destroy on reset_begin, ring_Create on reset_end.
+     _RingAllocator              ring;
+     IDirect3DVertexBuffer9*     ring_VB;
+     IC void                     ring_Create     ( u32 bytes )
+     {
+         CHK_DX              (HW.pDevice->CreateVertexBuffer(bytes,D3DUSAGE_DYNAMIC|D3DUSAGE_WRITEONLY,0,D3DPOOL_DEFAULT,&ring_VB,NULL));
+         ring.reset          (bytes);
+     }
+     IC void                     ring_Destroy    ()
+     {
+         ring.close          ();
+         _RELEASE            (ring_VB);
+     }
+     IC void                     ring_Begin      ()
+     {
+         void*   ptr;
+         CHK_DX              (ring_VB->Lock(0,0,&ptr,LOCKFLAGS_APPEND));
+         ring.open           (ptr);
+     }
+     IC void                     ring_End        ()
+     {
+         ring.close          ();
+         CHK_DX              (ring_VB->Unlock());
+         ring.fence          ();
+     }
+ 
      _VertexStream()             { _clear();     };
      ~_VertexStream()            { Destroy();    };
  };
@@ -64,6 +200,7 @@
          mSize       = 0;
          mPosition   = 0;
          mDiscardID  = 0;
+         ring_IB     = NULL;
      }
  public:
      void                        Create          ();
@@ -78,6 +215,32 @@
      u16*                        Lock            ( u32 Count, u32& vOffset );
      void                        Unlock          (u32 RealCount);
  
+     // Shared ring, see _VertexStream::ring_Begin (reserve with 'align' of 2, start index is offset/2)
+     _RingAllocator              ring;
+     IDirect3DIndexBuffer9*      ring_IB;
+     IC void                     ring_Create     ( u32 bytes )
+     {
+         CHK_DX              (HW.pDevice->CreateIndexBuffer(bytes,D3DUSAGE_DYNAMIC|D3DUSAGE_WRITEONLY,D3DFMT_INDEX16,D3DPOOL_DEFAULT,&ring_IB,NULL));
+         ring.reset          (bytes);
+     }
+     IC void                     ring_Destroy    ()
+     {
+         ring.close          ();
+         _RELEASE            (ring_IB);
+     }
+     IC void                     ring_Begin      ()
+     {
+         void*   ptr;
+         CHK_DX              (ring_IB->Lock(0,0,&ptr,LOCKFLAGS_APPEND));
+         ring.open           (ptr);
+     }
+     IC void                     ring_End        ()
+     {
+         ring.close          ();
+         CHK_DX              (ring_IB->Unlock());
+         ring.fence          ();
+     }
+ 
      _IndexStream()              { _clear();     };
      ~_IndexStream()             { Destroy();    };
  };
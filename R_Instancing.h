@@ -0,0 +1,198 @@
+ #ifndef r_InstancingH
+ #define r_InstancingH
+ #pragma once
+ 
+ // Hardware instancing (vs_3_0 and up)
+ // Batches are built on CPU: visuals push (key,instance) pairs, 'flush' sorts them by key
+ // and hands every run to the back end, which fills a range of the per-frame instance stream and issues one draw.
+ // Back end interface:
+ //      void*   Lock    (u32 count, u32 stride, u32& offset);
+ //      void    Unlock  (u32 count, u32 stride);
+ //      void    Draw    (const _key& key, u32 offset, u32 count);
+ // so batch construction can be checked against a recording back end without a device.
+ 
+ #pragma pack(push,4)
+ struct  R_instance
+ {
+     Fvector4                    m0,m1,m2;       // 3x4 xform (transposed), row 3 is (0,0,0,1)
+     Fvector4                    c_scale;        // rgb - static lighting, w - hemisphere
+     Fvector4                    c_bias;         // rgb - static lighting, w - hemisphere
+     Fvector4                    c_sun;          // x - scale, y - bias
+ 
+     IC void                     set_xform       (const Fmatrix& M)
+     {
+         m0.set                  (M._11, M._21, M._31, M._41);
+         m1.set                  (M._12, M._22, M._32, M._42);
+         m2.set                  (M._13, M._23, M._33, M._43);
+     }
+     IC void                     set_lighting    (const Fvector& rgb, float hemi, float sun)
+     {
+         c_scale.set             (rgb.x,rgb.y,rgb.z,hemi);
+         c_bias.set              (0,0,0,0);
+         c_sun.set               (sun,0,0,0);
+     }
+ };
+ 
+ struct  R_instance_key
+ {
+     ShaderElement*              element;
+     SGeometry*                  geom;           // declaration must fetch R_instance from stream 1
+     u32                         vBase,vCount;
+     u32                         iBase,dwPrimitives;
+ 
+     IC bool                     operator<       (const R_instance_key& K) const
+     {
+         if (element!=K.element) return  element<K.element;
+         if (geom!=K.geom)       return  geom<K.geom;
+         if (vBase!=K.vBase)     return  vBase<K.vBase;
+         if (vCount!=K.vCount)   return  vCount<K.vCount;
+         if (iBase!=K.iBase)     return  iBase<K.iBase;
+         return                  dwPrimitives<K.dwPrimitives;
+     }
+     IC bool                     operator==      (const R_instance_key& K) const
+     {
+         return                  (element==K.element) && (geom==K.geom) && (vBase==K.vBase) && (vCount==K.vCount) && (iBase==K.iBase) && (dwPrimitives==K.dwPrimitives);
+     }
+ };
+ #pragma pack(pop)
+ 
+ // Instanced declaration: 'base' (stream 0) followed by R_instance in stream 1 as float4 texcoords from 'usage_index' on
+ IC void                         R_instance_decl (VDeclarator& D, D3DVERTEXELEMENT9* base, u32 usage_index)
+ {
+     D.set                       (base);
+     D.resize                    (D.size()-1);   // D3DDECL_END
+     for (u32 i=0; i<sizeof(R_instance)/sizeof(Fvector4); ++i) {
+         D3DVERTEXELEMENT9       E = { 1, WORD(i*sizeof(Fvector4)), D3DDECLTYPE_FLOAT4, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_TEXCOORD, BYTE(usage_index+i) };
+         D.push_back             (E);
+     }
+     D3DVERTEXELEMENT9           end = D3DDECL_END();
+     D.push_back                 (end);
+ }
+ 
+ template <typename _key, typename _backend>
+ class R_InstanceBatcher
+ {
+ public:
+     struct  _item
+     {
+         _key                    key;
+         R_instance              data;
+ 
+         IC bool                 operator<       (const _item& I) const  { return key<I.key; }
+     };
+     typedef xr_vector<_item>    ITEMS;
+ protected:
+     ITEMS                       m_items;
+     xr_vector<R_instance>       m_scratch;
+     u32                         m_max_batch;    // limited by stream size
+     u32                         stat_batches;
+     u32                         stat_instances;
+ public:
+     R_InstanceBatcher           (u32 max_batch = 1024) : m_max_batch(max_batch), stat_batches(0), stat_instances(0)    {}
+ 
+     IC void                     add             (const _key& key, const R_instance& data)
+     {
+         m_items.push_back       (_item());
+         m_items.back().key      = key;
+         m_items.back().data     = data;
+     }
+     IC void                     clear           ()              { m_items.clear_not_free(); }
+     IC bool                     empty           () const        { return m_items.empty();   }
+     IC u32                      size            () const        { return u32(m_items.size());}
+     IC u32                      batches         () const        { return stat_batches;      }
+     IC u32                      instances       () const        { return stat_instances;    }
+ 
+     void                        flush           (_backend& B)
+     {
+         stat_batches            = 0;
+         stat_instances          = 0;
+         if (m_items.empty())    return;
+ 
+         std::stable_sort        (m_items.begin(),m_items.end());
+ 
+         typename ITEMS::const_iterator   I = m_items.begin();
+         typename ITEMS::const_iterator   E = m_items.end();
+         while (I!=E) {
+             typename ITEMS::const_iterator   R = I;
+             u32                 count = 0;
+             while ((R!=E) && (R->key==I->key) && (count<m_max_batch))
+                 ++R, ++count;
+ 
+             u32                 offset;
+             R_instance*         dest = (R_instance*)B.Lock(count,sizeof(R_instance),offset);
+             for (typename ITEMS::const_iterator J=I; J!=R; ++J, ++dest)
+                 *dest           = J->data;
+             B.Unlock            (count,sizeof(R_instance));
+             B.Draw              (I->key,offset,count);
+ 
+             ++stat_batches;
+             stat_instances      += count;
+             I                   = R;
+         }
+         clear                   ();
+     }
+ };
+ 
+ // D3D back end: instance data goes to the dynamic vertex stream, geometry is fetched with stream frequencies
+ class   R_InstanceBackend_D3D
+ {
+ public:
+     _VertexStream&              stream;
+ public:
+     R_InstanceBackend_D3D       (_VertexStream& _stream) : stream(_stream)  {}
+ 
+     IC void*                    Lock            (u32 count, u32 stride, u32& offset)    { return stream.Lock(count,stride,offset);  }
+     IC void                     Unlock          (u32 count, u32 stride)                 { stream.Unlock(count,stride);              }
+     IC void                     Draw            (const R_instance_key& K, u32 offset, u32 count)
+     {
+         RCache.set_Element      (K.element);
+         RCache.set_Geometry     (K.geom);
+         CHK_DX                  (HW.pDevice->SetStreamSource    (1,stream.Buffer(),offset*sizeof(R_instance),sizeof(R_instance)));
+         CHK_DX                  (HW.pDevice->SetStreamSourceFreq(0,D3DSTREAMSOURCE_INDEXEDDATA|count));
+         CHK_DX                  (HW.pDevice->SetStreamSourceFreq(1,D3DSTREAMSOURCE_INSTANCEDATA|1));
+         RCache.Render           (D3DPT_TRIANGLELIST,K.vBase,0,K.vCount,K.iBase,K.dwPrimitives);
+         CHK_DX                  (HW.pDevice->SetStreamSourceFreq(0,1));
+         CHK_DX                  (HW.pDevice->SetStreamSourceFreq(1,1));
+         CHK_DX                  (HW.pDevice->SetStreamSource    (1,NULL,0,0));
+     }
+ };
+ 
+ // Recording back end: keeps instance data in system memory and logs every draw
+ template <typename _key>
+ class   R_InstanceBackend_Record
+ {
+ public:
+     struct  _draw
+     {
+         _key                    key;
+         u32                     offset;
+         u32                     count;
+     };
+     xr_vector<u8>               memory;
+     xr_vector<_draw>            draws;
+ public:
+     IC void*                    Lock            (u32 count, u32 stride, u32& offset)
+     {
+         VERIFY                  (0==(memory.size()%stride));
+         offset                  = u32(memory.size())/stride;
+         memory.resize           (memory.size() + count*stride);
+         return                  (&*memory.begin() + offset*stride);
+     }
+     IC void                     Unlock          (u32 count, u32 stride)                 {}
+     IC void                     Draw            (const _key& K, u32 offset, u32 count)
+     {
+         draws.push_back         (_draw());
+         draws.back().key        = K;
+         draws.back().offset     = offset;
+         draws.back().count      = count;
+     }
+     IC void                     clear           ()                                      { memory.clear(); draws.clear();    }
+ };
+ 
+ typedef R_InstanceBatcher<R_instance_key,R_InstanceBackend_D3D> R_InstanceBatcher_D3D;
+ 
+ #endif
+
+
+
+
@@ -7,6 +7,8 @@
  
  #include    "shader.h"
  #include    "tss_def.h"
+ #include    "ResourceRegistry.h"
+ #include    "TextureStreaming.h"
  
  // refs
  struct      lua_State;
@@ -15,24 +17,21 @@
  class ENGINE_API CResourceManager
  {
  private:
-     struct str_pred : public std::binary_function<char*, char*, bool>   {
-         IC bool operator()(LPCSTR x, LPCSTR y) const
-         {   return xr_strcmp(x,y)<0;    }
-     };
      struct texture_detail   {
          const char*         T;
          R_constant_setup*   cs;
      };
  public:
-     DEFINE_MAP_PRED(const char*,IBlender*,      map_Blender,    map_BlenderIt,      str_pred);
-     DEFINE_MAP_PRED(const char*,CTexture*,      map_Texture,    map_TextureIt,      str_pred);
-     DEFINE_MAP_PRED(const char*,CMatrix*,       map_Matrix,     map_MatrixIt,       str_pred);
-     DEFINE_MAP_PRED(const char*,CConstant*,     map_Constant,   map_ConstantIt,     str_pred);
-     DEFINE_MAP_PRED(const char*,CRT*,           map_RT,         map_RTIt,           str_pred);
-     DEFINE_MAP_PRED(const char*,CRTC*,          map_RTC,        map_RTCIt,          str_pred);
-     DEFINE_MAP_PRED(const char*,SVS*,           map_VS,         map_VSIt,           str_pred);
-     DEFINE_MAP_PRED(const char*,SPS*,           map_PS,         map_PSIt,           str_pred);
-     DEFINE_MAP_PRED(const char*,texture_detail, map_TD,         map_TDIt,           str_pred);
+     // all registries are keyed by case insensitive names, 'first' is the lowercase name
+     typedef CResourceRegistry<IBlender*>        map_Blender;    typedef map_Blender::iterator   map_BlenderIt;
+     typedef CResourceRegistry<CTexture*>        map_Texture;    typedef map_Texture::iterator   map_TextureIt;
+     typedef CResourceRegistry<CMatrix*>         map_Matrix;     typedef map_Matrix::iterator    map_MatrixIt;
+     typedef CResourceRegistry<CConstant*>       map_Constant;   typedef map_Constant::iterator  map_ConstantIt;
+     typedef CResourceRegistry<CRT*>             map_RT;         typedef map_RT::iterator        map_RTIt;
+     typedef CResourceRegistry<CRTC*>            map_RTC;        typedef map_RTC::iterator       map_RTCIt;
+     typedef CResourceRegistry<SVS*>             map_VS;         typedef map_VS::iterator        map_VSIt;
+     typedef CResourceRegistry<SPS*>             map_PS;         typedef map_PS::iterator        map_PSIt;
+     typedef CResourceRegistry<texture_detail>   map_TD;         typedef map_TD::iterator        map_TDIt;
  private:
      // data
      map_Blender                                         m_blenders;
@@ -66,6 +65,7 @@
      xr_vector<std::pair<shared_str,R_constant_setup*> > v_constant_setup;
      lua_State*                                          LSVM;
      BOOL                                                bDeferredLoad;
+     CTextureStreamer*                                   m_streamer;         // NULL - textures are loaded whole on first use
  private:
      void                            LS_Load             ();
      void                            LS_Unload           ();
@@ -91,6 +91,14 @@
      void                            ED_UpdateTextures   (AStringVec* names);
  #endif
  
+     // Lookups by name: no lowercase copy, no interning
+     IC CTexture*                    _FindTexture        (const shared_str& Name)    { map_TextureIt I = m_textures.find(Name);  return (I==m_textures.end()) ? 0 : I->second;   }
+     IC CMatrix*                     _FindMatrix         (const shared_str& Name)    { map_MatrixIt  I = m_matrices.find(Name);  return (I==m_matrices.end()) ? 0 : I->second;   }
+     IC CConstant*                   _FindConstant       (const shared_str& Name)    { map_ConstantIt I= m_constants.find(Name); return (I==m_constants.end())? 0 : I->second;   }
+     IC CRT*                         _FindRT             (const shared_str& Name)    { map_RTIt      I = m_rtargets.find(Name);  return (I==m_rtargets.end()) ? 0 : I->second;   }
+     IC SVS*                         _FindVS             (const shared_str& Name)    { map_VSIt      I = m_vs.find(Name);        return (I==m_vs.end())       ? 0 : I->second;   }
+     IC SPS*                         _FindPS             (const shared_str& Name)    { map_PSIt      I = m_ps.find(Name);        return (I==m_ps.end())       ? 0 : I->second;   }
+ 
      // Low level resource creation
      CTexture*                       _CreateTexture      (LPCSTR Name);
      void                            _DeleteTexture      (const CTexture* T);
@@ -143,7 +151,7 @@
      Shader*                         _lua_Create         (LPCSTR     s_shader,   LPCSTR s_textures);
      BOOL                            _lua_HasShader      (LPCSTR     s_shader);
  
-     CResourceManager                        () : bDeferredLoad(TRUE), m_description(0)  {   }
+     CResourceManager                        () : bDeferredLoad(TRUE), m_description(0), m_streamer(0)  {   }
  
      void            OnDeviceCreate          (IReader* F);
      void            OnDeviceCreate          (LPCSTR name);
@@ -165,6 +173,11 @@
      void            DeferredUpload          ();
      void            DeferredUnload          ();
      void            Evict                   ();
+ 
+     // Texture streaming, usage feedback comes from visibility ('pixels' - projected size)
+     IC void         StreamTouch             (CTexture* T, float pixels) { if (m_streamer && T->flags.bStreamed) m_streamer->touch(T->m_stream_id,pixels);   }
+     IC void         StreamUpdate            ()                          { if (m_streamer)   m_streamer->update();   }
+     IC void         StreamRemove            (CTexture* T)               { if (m_streamer && T->flags.bStreamed) { m_streamer->remove(T->m_stream_id); T->flags.bStreamed = FALSE; } }
  };
  
  #endif //ResourceManagerH
@@ -0,0 +1,175 @@
+ #ifndef ResourceRegistryH
+ #define ResourceRegistryH
+ #pragma once
+ 
+ // Open-addressing registry keyed by resource names, case insensitive
+ // - the hash of the lowercase bytes is kept per slot, names are compared only when the hashes match
+ // - lookups take plain strings and intern nothing, the name is interned once on insert
+ // - linear probing with tombstones, grows at 3/4 load (tombstones included)
+ // - iterators expose 'first' (const char* name) / 'second' (data) like the maps it replaces
+ 
+ // interned lowercase name
+ IC shared_str   resource_name   (LPCSTR N)
+ {
+     string_path                 lower;
+     strcpy                      (lower,N);
+     strlwr                      (lower);
+     return                      (shared_str(lower));
+ }
+ 
+ // FNV-1a over the lowercase bytes
+ IC u32          resource_hash   (LPCSTR N)
+ {
+     u32                         h = 2166136261u;
+     for ( ; *N; ++N)
+         h                       = (h ^ u32(u8(tolower(*N)))) * 16777619u;
+     return                      (h);
+ }
+ 
+ template <typename T>
+ class CResourceRegistry
+ {
+ public:
+     struct  value_type
+     {
+         const char*             first;
+         T                       second;
+     };
+ private:
+     enum    { slot_empty = 0, slot_used, slot_deleted };
+     xr_vector<value_type>       m_slots;
+     xr_vector<shared_str>       m_names;        // keep the names of 'first' alive
+     xr_vector<u32>              m_hashes;
+     xr_vector<u8>               m_state;
+     u32                         m_count;
+     u32                         m_deleted;
+ 
+     IC u32                      mask            () const        { return u32(m_slots.size()) - 1;   }
+ 
+     // returns slot with the key or the first free slot of the probe sequence
+     IC u32                      probe           (LPCSTR N, u32 H) const
+     {
+         u32                     m       = mask();
+         u32                     i       = H & m;
+         u32                     free    = u32(-1);
+         for (;;) {
+             switch (m_state[i]) {
+                 case slot_empty:    return  (free!=u32(-1)) ? free : i;
+                 case slot_deleted:  if (free==u32(-1))  free = i;   break;
+                 case slot_used:     if ((m_hashes[i]==H) && ((m_slots[i].first==N) || !stricmp(m_slots[i].first,N)))   return i;   break;
+             }
+             i                   = (i+1) & m;
+         }
+     }
+     void                        rehash          (u32 size)
+     {
+         xr_vector<value_type>   slots;
+         xr_vector<shared_str>   names;
+         xr_vector<u32>          hashes;
+         xr_vector<u8>           state;
+         slots.swap              (m_slots);
+         names.swap              (m_names);
+         hashes.swap             (m_hashes);
+         state.swap              (m_state);
+         _reset                  (size);
+         for (u32 i=0, n=u32(slots.size()); i<n; ++i)
+             if (slot_used==state[i]) {
+                 u32             j = probe(*names[i],hashes[i]);
+                 m_state[j]      = slot_used;
+                 m_slots[j]      = slots[i];
+                 m_names[j]      = names[i];
+                 m_hashes[j]     = hashes[i];
+                 ++m_count;
+             }
+     }
+     void                        _reset          (u32 size)
+     {
+         m_slots.clear           ();
+         m_names.clear           ();
+         m_slots.resize          (size);
+         m_names.resize          (size);
+         m_hashes.assign         (size,0);
+         m_state.assign          (size,u8(slot_empty));
+         m_count                 = 0;
+         m_deleted               = 0;
+     }
+ public:
+     class   iterator
+     {
+         friend class            CResourceRegistry<T>;
+         CResourceRegistry<T>*   R;
+         u32                     i;
+         IC void                 skip            ()              { while ((i<R->m_state.size()) && (slot_used!=R->m_state[i])) ++i;  }
+     public:
+         iterator                ()                                          : R(0), i(0)    {}
+         iterator                (CResourceRegistry<T>* _R, u32 _i)          : R(_R), i(_i)  { skip();   }
+         IC value_type&          operator*       () const        { return R->m_slots[i];     }
+         IC value_type*          operator->      () const        { return &R->m_slots[i];    }
+         IC iterator&            operator++      ()              { ++i; skip(); return *this;}
+         IC bool                 operator==      (const iterator& I) const   { return i==I.i;    }
+         IC bool                 operator!=      (const iterator& I) const   { return i!=I.i;    }
+     };
+     typedef iterator            const_iterator;
+ 
+     CResourceRegistry           ()                              { _reset(64);                               }
+ 
+     IC iterator                 begin           ()              { return iterator(this,0);                  }
+     IC iterator                 end             ()              { return iterator(this,u32(m_slots.size()));}
+     IC u32                      size            () const        { return m_count;                           }
+     IC bool                     empty           () const        { return 0==m_count;                        }
+ 
+     IC iterator                 find            (LPCSTR N)
+     {
+         u32                     i = probe(N,resource_hash(N));
+         return                  (slot_used==m_state[i]) ? iterator(this,i) : end();
+     }
+     IC iterator                 find            (const shared_str& K)   { return find(*K);                  }
+ 
+     iterator                    insert          (LPCSTR N, const T& V)
+     {
+         if (4*(m_count+m_deleted+1) > 3*m_slots.size())
+             rehash              ((4*(m_count+1) > 2*m_slots.size()) ? 2*u32(m_slots.size()) : u32(m_slots.size()));
+ 
+         u32                     H = resource_hash(N);
+         u32                     i = probe(N,H);
+         if (slot_used!=m_state[i]) {
+             if (slot_deleted==m_state[i])   --m_deleted;
+             m_state[i]          = slot_used;
+             m_names[i]          = resource_name(N);
+             m_hashes[i]         = H;
+             m_slots[i].first    = *m_names[i];
+             ++m_count;
+         }
+         m_slots[i].second       = V;
+         return                  iterator(this,i);
+     }
+     IC iterator                 insert          (const std::pair<LPCSTR,T>& P)  { return insert(P.first,P.second);  }
+     IC T&                       operator[]      (LPCSTR N)
+     {
+         iterator                I = find(N);
+         if (I==end())           I = insert(N,T());
+         return                  I->second;
+     }
+ 
+     IC void                     erase           (iterator I)
+     {
+         VERIFY                  (slot_used==m_state[I.i]);
+         m_state[I.i]            = slot_deleted;
+         m_slots[I.i].first      = 0;
+         m_names[I.i]            = shared_str();
+         --m_count;
+         ++m_deleted;
+     }
+     IC void                     erase           (LPCSTR N)
+     {
+         iterator                I = find(N);
+         if (I!=end())           erase(I);
+     }
+     IC void                     clear           ()              { _reset(64);                               }
+ };
+ 
+ #endif //ResourceRegistryH
+
+
+
+
@@ -13,6 +13,7 @@
          u32                 bLoaded     : 1;
          u32                 bUser       : 1;
          u32                 seqCycles   : 1;
+         u32                 bStreamed   : 1;    // larger mips are managed by CTextureStreamer
          u32                 MemoryUsage : 28;
  
      }                                   flags;
@@ -20,6 +21,7 @@
      CAviPlayerCustom*                   pAVI;
      float                               m_material;
      shared_str                              m_bumpmap;
+     u32                                 m_stream_id;        // CTextureStreamer entry, valid if flags.bStreamed
  
      // Sequence data
      u32                                 seqMSPF;            // milliseconds per frame
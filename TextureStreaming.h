@@ -0,0 +1,311 @@
+ #ifndef TextureStreamingH
+ #define TextureStreamingH
+ #pragma once
+ 
+ #include "xrSyncronize.h"
+ 
+ class ENGINE_API CTexture;
+ 
+ // Texture streaming
+ // Every streamed texture keeps its smallest mips resident, larger mips are requested by screen-space priority
+ // and granted under the memory budget. Requests go through three stages:
+ //      I/O thread      - 'read'    raw file data for mips [mip_first..]
+ //      decode thread   - 'decode'  raw data into the device layout
+ //      render thread   - 'upload'  into the surface (bounded number per frame), 'trim' to drop mips
+ // The source does all file and device work, so priority, budget and job flow can be driven without a device.
+ 
+ class ENGINE_API ITextureStreamSource
+ {
+ public:
+     virtual                     ~ITextureStreamSource   ()  {}
+     virtual BOOL                read                    (CTexture* T, u32 mip_first, xr_vector<u8>& raw)                        = 0;
+     virtual BOOL                decode                  (CTexture* T, u32 mip_first, const xr_vector<u8>& raw, xr_vector<u8>& mips) = 0;
+     virtual void                upload                  (CTexture* T, u32 mip_first, const xr_vector<u8>& mips)                = 0;
+     virtual void                trim                    (CTexture* T, u32 mip_first)                                            = 0;
+ };
+ 
+ class CTextureStreamer
+ {
+ public:
+     enum    { stream_no_mip = u8(-1) };
+     struct  SEntry
+     {
+         CTexture*               texture;
+         u32                     size;           // largest dimension of mip 0
+         u32                     bytes;          // size of mip 0 in bytes
+         u8                      mip_count;
+         u8                      mip_resident;   // first resident mip
+         u8                      mip_wanted;     // first mip granted by the budget
+         u8                      mip_pending;    // first mip being loaded (stream_no_mip if idle)
+         float                   priority;       // projected size in pixels, aged every update
+     };
+     struct  SJob
+     {
+         u32                     id;
+         CTexture*               texture;
+         u32                     mip_first;
+         BOOL                    failed;         // returned to the render thread to clear 'mip_pending'
+         xr_vector<u8>           raw;
+         xr_vector<u8>           data;
+     };
+     typedef xr_vector<SEntry>   ENTRIES;
+     typedef xr_deque<SJob*>     JOBS;
+ protected:
+     ITextureStreamSource*       m_source;
+     ENTRIES                     m_entries;      // 'texture' is NULL for removed entries
+     xr_vector<u32>              m_free;         // removed entries to reuse
+     xr_vector<u32>              m_order;        // scratch for budget pass
+ 
+     xrCriticalSection           m_cs;
+     JOBS                        m_io;
+     JOBS                        m_decode;
+     JOBS                        m_upload;
+     volatile BOOL               m_quit;
+     volatile LONG               m_threads;
+ 
+     u32                         m_budget;       // bytes
+     u32                         m_tail_size;    // mips of this size and below are always resident
+     u32                         m_uploads_per_frame;
+     float                       m_aging;
+ public:
+     u32                         stat_resident;
+     u32                         stat_requested;
+ protected:
+     IC SJob*                    pop             (JOBS& Q)
+     {
+         m_cs.Enter              ();
+         SJob*                   J = Q.empty() ? 0 : Q.front();
+         if (J)                  Q.pop_front();
+         m_cs.Leave              ();
+         return                  J;
+     }
+     IC void                     push            (JOBS& Q, SJob* J)
+     {
+         m_cs.Enter              ();
+         Q.push_back             (J);
+         m_cs.Leave              ();
+     }
+     // render thread only
+     IC void                     finish          (SJob* J)
+     {
+         m_entries[J->id].mip_pending    = stream_no_mip;
+         xr_delete               (J);
+     }
+     IC void                     flush           (JOBS& Q)
+     {
+         while (!Q.empty())      { xr_delete(Q.front()); Q.pop_front(); }
+     }
+     // under m_cs
+     IC BOOL                     cancel          (JOBS& Q, u32 id)
+     {
+         for (JOBS::iterator I=Q.begin(); I!=Q.end(); ++I)
+             if ((*I)->id == id) { xr_delete(*I); Q.erase(I); return TRUE; }
+         return                  FALSE;
+     }
+     struct  priority_pred
+     {
+         const ENTRIES*          E;
+         priority_pred           (const ENTRIES* _E) : E(_E) {}
+         IC bool                 operator()      (u32 a, u32 b) const    { return (*E)[a].priority > (*E)[b].priority; }
+     };
+ public:
+     CTextureStreamer            (ITextureStreamSource* source, u32 budget, u32 tail_size = 64, u32 uploads_per_frame = 4) :
+         m_source(source), m_quit(FALSE), m_threads(0), m_budget(budget), m_tail_size(tail_size),
+         m_uploads_per_frame(uploads_per_frame), m_aging(.9f), stat_resident(0), stat_requested(0)  {}
+     ~CTextureStreamer           ()
+     {
+         if (m_threads)          stop();
+         flush                   (m_io);
+         flush                   (m_decode);
+         flush                   (m_upload);
+     }
+ 
+     // mip math
+     IC static u32               mip_for_screen  (u32 size, float pixels, u32 mip_count)
+     {
+         u32                     mip = 0;
+         while ((mip+1<mip_count) && (float(size>>(mip+1)) >= pixels))
+             ++mip;
+         return                  mip;
+     }
+     IC static u32               mip_bytes       (u32 bytes, u32 mip_first, u32 mip_count)
+     {
+         u32                     result = 0;
+         for (u32 m=mip_first; m<mip_count; ++m)
+             result              += _max(bytes>>(2*m),u32(16));
+         return                  result;
+     }
+     IC u32                      mip_tail        (const SEntry& E) const
+     {
+         u32                     mip = 0;
+         while ((mip+1<E.mip_count) && ((E.size>>mip) > m_tail_size))
+             ++mip;
+         return                  mip;
+     }
+ 
+     // render thread: registration and usage feedback
+     u32                         add             (CTexture* T, u32 size, u32 bytes, u32 mip_count)
+     {
+         VERIFY                  (mip_count && (mip_count<stream_no_mip));
+         SEntry                  E;
+         E.texture               = T;
+         E.size                  = size;
+         E.bytes                 = bytes;
+         E.mip_count             = u8(mip_count);
+         E.mip_resident          = u8(mip_tail(E));  // loaded synchronously by the caller
+         E.mip_wanted            = E.mip_resident;
+         E.mip_pending           = stream_no_mip;
+         E.priority              = 0.f;
+         if (!m_free.empty())
+         {
+             u32                 id  = m_free.back();
+             m_free.pop_back     ();
+             m_entries[id]       = E;
+             return              id;
+         }
+         m_entries.push_back     (E);
+         return                  u32(m_entries.size()-1);
+     }
+     // before the texture is destroyed: the pending job is cancelled (waiting for a worker
+     // to hand it over if it is being read or decoded right now), the entry is tombstoned
+     void                        remove          (u32 id)
+     {
+         SEntry&                 E = m_entries[id];
+         VERIFY                  (E.texture);
+         while (stream_no_mip != E.mip_pending)
+         {
+             m_cs.Enter          ();
+             BOOL                found = cancel(m_io,id) || cancel(m_decode,id) || cancel(m_upload,id);
+             m_cs.Leave          ();
+             if (found)          E.mip_pending = stream_no_mip;
+             else                Sleep(0);
+         }
+         E.texture               = 0;
+         E.bytes                 = 0;
+         E.mip_count             = 0;
+         E.mip_resident          = 0;
+         E.mip_wanted            = 0;
+         E.priority              = 0.f;
+         m_free.push_back        (id);
+     }
+     IC void                     touch           (u32 id, float pixels)
+     {
+         SEntry&                 E = m_entries[id];
+         if (pixels > E.priority) E.priority = pixels;
+     }
+     IC const SEntry&            entry           (u32 id) const  { return m_entries[id];     }
+     IC void                     set_budget      (u32 budget)    { m_budget = budget;        }
+ 
+     // render thread, once per frame: budget pass, new requests, trims and bounded uploads
+     void                        update          ()
+     {
+         m_order.resize          (m_entries.size());
+         for (u32 i=0, n=u32(m_entries.size()); i<n; ++i)
+             m_order[i]          = i;
+         std::sort               (m_order.begin(),m_order.end(),priority_pred(&m_entries));
+ 
+         // tails are always resident
+         u32                     used = 0;
+         for (ENTRIES::iterator I=m_entries.begin(), E=m_entries.end(); I!=E; ++I)
+             if ((*I).texture)   used += mip_bytes((*I).bytes,mip_tail(*I),(*I).mip_count);
+ 
+         // grant detail by priority, each texture gets the best mip still fitting into the budget
+         for (xr_vector<u32>::const_iterator I=m_order.begin(), E=m_order.end(); I!=E; ++I) {
+             SEntry&             T       = m_entries[*I];
+             if (!T.texture)     continue;
+             u32                 tail    = mip_tail(T);
+             u32                 mip     = (T.priority>0.f) ? mip_for_screen(T.size,T.priority,T.mip_count) : tail;
+             mip                 = _min(mip,tail);
+             u32                 base    = mip_bytes(T.bytes,tail,T.mip_count);
+             while ((mip<tail) && (used + mip_bytes(T.bytes,mip,T.mip_count) - base > m_budget))
+                 ++mip;
+             used                += mip_bytes(T.bytes,mip,T.mip_count) - base;
+             T.mip_wanted        = u8(mip);
+             T.priority          *= m_aging;
+         }
+ 
+         stat_resident           = 0;
+         for (u32 i=0, n=u32(m_entries.size()); i<n; ++i) {
+             SEntry&             T       = m_entries[i];
+             if (!T.texture)     continue;
+             if (T.mip_wanted > T.mip_resident) {
+                 m_source->trim  (T.texture,T.mip_wanted);
+                 T.mip_resident  = T.mip_wanted;
+             }
+             else if ((T.mip_wanted < T.mip_resident) && (stream_no_mip==T.mip_pending)) {
+                 SJob*           J   = xr_new<SJob>();
+                 J->id           = i;
+                 J->texture      = T.texture;
+                 J->mip_first    = T.mip_wanted;
+                 J->failed       = FALSE;
+                 T.mip_pending   = T.mip_wanted;
+                 push            (m_io,J);
+                 ++stat_requested;
+             }
+             stat_resident       += mip_bytes(T.bytes,T.mip_resident,T.mip_count);
+         }
+ 
+         for (u32 i=0; i<m_uploads_per_frame; ++i) {
+             SJob*               J   = pop(m_upload);
+             if (!J)             break;
+             SEntry&             T   = m_entries[J->id];
+             // the budget could have been cut while the job was in flight
+             if (!J->failed && (J->mip_first >= T.mip_wanted) && (J->mip_first < T.mip_resident)) {
+                 m_source->upload(T.texture,J->mip_first,J->data);
+                 T.mip_resident  = u8(J->mip_first);
+             }
+             finish              (J);
+         }
+     }
+ 
+     // worker steps, return FALSE if there was nothing to do
+     BOOL                        io_step         ()
+     {
+         SJob*                   J   = pop(m_io);
+         if (!J)                 return FALSE;
+         J->failed               = !m_source->read(J->texture,J->mip_first,J->raw);
+         push                    (J->failed ? m_upload : m_decode,J);
+         return                  TRUE;
+     }
+     BOOL                        decode_step     ()
+     {
+         SJob*                   J   = pop(m_decode);
+         if (!J)                 return FALSE;
+         J->failed               = !m_source->decode(J->texture,J->mip_first,J->raw,J->data);
+         J->raw.clear            ();
+         push                    (m_upload,J);
+         return                  TRUE;
+     }
+ 
+     // threads
+     static void __cdecl         io_thread       (void* P)
+     {
+         CTextureStreamer*       S   = (CTextureStreamer*)P;
+         while (!S->m_quit)      if (!S->io_step())      Sleep(1);
+         InterlockedDecrement    (&S->m_threads);
+     }
+     static void __cdecl         decode_thread   (void* P)
+     {
+         CTextureStreamer*       S   = (CTextureStreamer*)P;
+         while (!S->m_quit)      if (!S->decode_step())  Sleep(1);
+         InterlockedDecrement    (&S->m_threads);
+     }
+     void                        start           ()
+     {
+         m_quit                  = FALSE;
+         m_threads               = 2;
+         thread_spawn            (io_thread,     "X-RAY: texture I/O",      0,this);
+         thread_spawn            (decode_thread, "X-RAY: texture decode",   0,this);
+     }
+     void                        stop            ()
+     {
+         m_quit                  = TRUE;
+         while (m_threads)       Sleep(1);
+     }
+ };
+ 
+ #endif //TextureStreamingH
+
+
+
+
@@ -8,6 +8,7 @@
  #pragma once
  
  class   CGameGraph;
+ class   CGameGraphHierarchy;
  class   CGameLevelCrossTable;
  class   CLevelGraph;
  class   CGraphEngine;
@@ -15,15 +16,19 @@
  class   CALifeSimulator;
  class   CCoverManager;
  class   CScriptEngine;
+ class   CVisionService;
+ class   CSoundEventDispatcher;
  
  class CAI_Space {
  private:
      friend class CALifeSimulator;
      friend class CALifeGraphRegistry;
      friend class CLevel;
+     friend class CAI_SpaceLoader;
  
  private:
      CGameGraph                          *m_game_graph;
+     CGameGraphHierarchy                 *m_game_graph_hierarchy;
      CGameLevelCrossTable                *m_cross_table;
      CLevelGraph                         *m_level_graph;
      CGraphEngine                        *m_graph_engine;
@@ -31,6 +36,8 @@
      CALifeSimulator                     *m_alife_simulator;
      CCoverManager                       *m_cover_manager;
      CScriptEngine                       *m_script_engine;
+     CVisionService                      *m_vision_service;
+     CSoundEventDispatcher               *m_sound_dispatcher;
  
  private:
              void                        load            (LPCSTR             level_name);
@@ -42,6 +49,7 @@
      virtual                             ~CAI_Space      ();
      IC      CGameGraph                  &game_graph     () const;
      IC      CGameGraph                  *get_game_graph () const;
+     IC      CGameGraphHierarchy         &game_graph_hierarchy() const;
      IC      CLevelGraph                 &level_graph    () const;
      IC      const CLevelGraph           *get_level_graph() const;
      IC      const CGameLevelCrossTable  &cross_table    () const;
@@ -52,6 +60,8 @@
      IC      const CALifeSimulator       *get_alife      () const;
      IC      const CCoverManager         &cover_manager  () const;
      IC      CScriptEngine               &script_engine  () const;
+     IC      CVisionService              &vision_service () const;
+     IC      CSoundEventDispatcher       &sound_dispatcher() const;
  
  #ifdef DEBUG
              void                        validate        (const u32          level_id) const;
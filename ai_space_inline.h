@@ -18,6 +18,12 @@
      return          (m_game_graph);
  }
  
+ IC  CGameGraphHierarchy         &CAI_Space::game_graph_hierarchy() const
+ {
+     VERIFY          (m_game_graph_hierarchy);
+     return          (*m_game_graph_hierarchy);
+ }
+ 
  IC  CLevelGraph                 &CAI_Space::level_graph     () const
  {
      VERIFY          (m_level_graph);
@@ -80,6 +86,18 @@
      return          (*m_script_engine);
  }
  
+ IC  CVisionService              &CAI_Space::vision_service  () const
+ {
+     VERIFY          (m_vision_service);
+     return          (*m_vision_service);
+ }
+ 
+ IC  CSoundEventDispatcher       &CAI_Space::sound_dispatcher() const
+ {
+     VERIFY          (m_sound_dispatcher);
+     return          (*m_sound_dispatcher);
+ }
+ 
  IC  CAI_Space                   &ai                         ()
  {
      if (!g_ai_space)
@@ -0,0 +1,139 @@
+ //  Module      : ai_space_loader.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : AI space level data loader
+ 
+ #pragma once
+ 
+ class CAI_Space;
+ class CLevelGraph;
+ class CGameLevelCrossTable;
+ 
+ // Level data sets do not depend on each other while they are read and decoded, so
+ // every one of them is a job processed on a worker thread. Workers claim jobs by an
+ // interlocked counter, the job list is fixed once started. Nothing is visible to the
+ // game until publish, which runs on the calling thread after all the workers
+ // finished and replaces the level data in CAI_Space at once.
+ // FS is not thread safe : a job opens and closes its files under the loader lock and
+ // decodes outside of it. The level graph maps its file in its constructor, so it is
+ // built under the lock, the cross table is compressed from the opened file outside
+ // of it. ALife managers add their own stream jobs (patrol paths, spawn objects)
+ // before start. Cover points are computed from the published level graph, so it is
+ // done in publish.
+ 
+ class CAI_SpaceLoader {
+ public:
+     class CJob {
+     public:
+         virtual             ~CJob           () {}
+         // worker thread, under the loader lock
+         virtual void        open            () {}
+         // worker thread, must not touch the published game state
+         virtual void        process         () = 0;
+         // worker thread, under the loader lock
+         virtual void        close           () {}
+         // calling thread, after every job is processed
+         virtual void        publish         () = 0;
+     };
+ 
+ protected:
+     template <typename T>
+     class CLevelDataJob : public CJob {
+     protected:
+         T                   *&m_result;
+ 
+     public:
+         IC                  CLevelDataJob   (T *&result) : m_result(result) {}
+         virtual void        open            ()
+         {
+             m_result        = xr_new<T>();
+         }
+         virtual void        process         () {}
+         virtual void        publish         () {}
+     };
+ 
+     // opens the file for a T constructed from the IReader, T keeps or deletes the stream
+     template <typename T>
+     class CStreamOwnerJob : public CJob {
+     protected:
+         T                   *&m_result;
+         string_path         m_file_name;
+         IReader             *m_stream;
+ 
+     public:
+         IC                  CStreamOwnerJob (T *&result, LPCSTR path_alias, LPCSTR file_name) : m_result(result), m_stream(0)
+         {
+             FS.update_path  (m_file_name,path_alias,file_name);
+         }
+         virtual void        open            ()
+         {
+             m_stream        = FS.r_open(m_file_name);
+         }
+         virtual void        process         ()
+         {
+             m_result        = xr_new<T>(m_stream);
+             m_stream        = 0;
+         }
+         virtual void        publish         () {}
+     };
+ 
+ public:
+     // reads 'file_name' into a new T with T::load(IReader&)
+     template <typename T>
+     class CStreamJob : public CJob {
+     protected:
+         T                   *&m_result;
+         string_path         m_file_name;
+         IReader             *m_stream;
+ 
+     public:
+         IC                  CStreamJob      (T *&result, LPCSTR path_alias, LPCSTR file_name) : m_result(result), m_stream(0)
+         {
+             FS.update_path  (m_file_name,path_alias,file_name);
+         }
+         virtual void        open            ()
+         {
+             m_stream        = FS.r_open(m_file_name);
+         }
+         virtual void        process         ()
+         {
+             R_ASSERT3       (m_stream,"Can't open level data file",m_file_name);
+             m_result        = xr_new<T>();
+             m_result->load  (*m_stream);
+         }
+         virtual void        close           ()
+         {
+             FS.r_close      (m_stream);
+         }
+         virtual void        publish         () {}
+     };
+ 
+ protected:
+     typedef xr_vector<CJob*>    JOBS;
+ 
+ protected:
+     JOBS                    m_jobs;
+     volatile LONG           m_next_job;
+     volatile LONG           m_threads;
+     xrCriticalSection       m_fs_lock;
+     CLevelGraph             *m_level_graph;
+     CGameLevelCrossTable    *m_cross_table;
+ 
+ protected:
+     static  void __cdecl    worker_thread   (void *loader);
+ 
+ public:
+     IC                      CAI_SpaceLoader ();
+     IC virtual              ~CAI_SpaceLoader();
+     IC      void            add             (CJob *job);
+     IC      void            start           (u32 thread_count = 2);
+     IC      bool            ready           () const;
+     IC      void            wait            () const;
+     IC      void            publish         (CAI_Space &ai_space);
+ };
+ 
+ #include "ai_space_loader_inline.h"
+
+
+
+
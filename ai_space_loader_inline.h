@@ -0,0 +1,102 @@
+ //  Module      : ai_space_loader_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : AI space level data loader inline functions
+ 
+ #pragma once
+ 
+ #include "ai_space.h"
+ #include "level_graph.h"
+ #include "game_level_cross_table.h"
+ #include "cover_manager.h"
+ 
+ IC  CAI_SpaceLoader::CAI_SpaceLoader    ()
+ {
+     m_next_job              = 0;
+     m_threads               = 0;
+     m_level_graph           = 0;
+     m_cross_table           = 0;
+     m_jobs.push_back        (xr_new<CLevelDataJob<CLevelGraph> >(m_level_graph));
+     m_jobs.push_back        (xr_new<CStreamOwnerJob<CGameLevelCrossTable> >(m_cross_table,"$level$",CROSS_TABLE_NAME));
+ }
+ 
+ IC  CAI_SpaceLoader::~CAI_SpaceLoader   ()
+ {
+     wait                    ();
+     delete_data             (m_jobs);
+     xr_delete               (m_level_graph);
+     xr_delete               (m_cross_table);
+ }
+ 
+ IC  void __cdecl CAI_SpaceLoader::worker_thread(void *loader)
+ {
+     CAI_SpaceLoader         *self = (CAI_SpaceLoader*)loader;
+     for (;;) {
+         LONG                index = InterlockedIncrement(&self->m_next_job) - 1;
+         if (index >= LONG(self->m_jobs.size()))
+             break;
+         CJob                *job = self->m_jobs[index];
+         self->m_fs_lock.Enter();
+         job->open           ();
+         self->m_fs_lock.Leave();
+ 
+         job->process        ();
+ 
+         self->m_fs_lock.Enter();
+         job->close          ();
+         self->m_fs_lock.Leave();
+     }
+     InterlockedDecrement    (&self->m_threads);
+ }
+ 
+ IC  void CAI_SpaceLoader::add           (CJob *job)
+ {
+     VERIFY2                 (!m_next_job && !m_threads,"Level data loader is already started");
+     m_jobs.push_back        (job);
+ }
+ 
+ IC  void CAI_SpaceLoader::start         (u32 thread_count)
+ {
+     VERIFY2                 (!m_next_job && !m_threads,"Level data loader is already started");
+     thread_count            = _max(u32(1),_min(thread_count,u32(m_jobs.size())));
+     m_threads               = LONG(thread_count);
+     for (u32 i=0; i<thread_count; ++i)
+         thread_spawn        (worker_thread,"X-RAY: level data loader",0,this);
+ }
+ 
+ IC  bool CAI_SpaceLoader::ready         () const
+ {
+     return                  (!m_threads);
+ }
+ 
+ IC  void CAI_SpaceLoader::wait          () const
+ {
+     while (m_threads)
+         Sleep               (1);
+ }
+ 
+ IC  void CAI_SpaceLoader::publish       (CAI_Space &ai_space)
+ {
+     wait                    ();
+     VERIFY2                 (m_next_job >= LONG(m_jobs.size()),"Level data loader is not started");
+     VERIFY                  (m_level_graph && m_cross_table);
+ 
+     xr_delete               (ai_space.m_level_graph);
+     xr_delete               (ai_space.m_cross_table);
+     ai_space.m_level_graph  = m_level_graph;
+     ai_space.m_cross_table  = m_cross_table;
+     m_level_graph           = 0;
+     m_cross_table           = 0;
+ 
+     ai_space.m_cover_manager->compute_static_cover();
+     ai_space.m_cover_manager->query_cache().clear();
+ 
+     JOBS::iterator          I = m_jobs.begin();
+     JOBS::iterator          E = m_jobs.end();
+     for ( ; I != E; ++I)
+         (*I)->publish       ();
+ }
+
+
+
+
@@ -8,6 +8,7 @@
  #pragma once
  
  #include "alife_simulator_base.h"
+ #include "alife_combat_partition.h"
  
  class CALifeCombatManager : public virtual CALifeSimulatorBase, CRandom {
  protected:
@@ -21,6 +22,17 @@
      CSE_ALifeSchedulable            *m_tpaCombatObjects[2];
      ALife::D_OBJECT_MAP             m_tpGraphPointObjects;
  
+     // partitioned interaction pass
+     struct CCombatFilter {
+         const CALifeCombatManager   *m_manager;
+ 
+         IC                          CCombatFilter               (const CALifeCombatManager *manager) : m_manager(manager) {}
+         IC  bool                    operator()                  (CSE_ALifeSchedulable *tpALifeSchedulable1, CSE_ALifeSchedulable *tpALifeSchedulable2) const;
+     };
+ 
+     CALifeCombatPartition           m_combat_partition;
+     CALifeCombatPartition::PAIRS    m_combat_pairs;
+ 
  public:
      ALife::ITEM_P_VECTOR            m_tpTempItemBuffer;
  
@@ -31,6 +43,8 @@
              void                    vfPerformAttackAction       (int                        iCombatGroupIndex);
              bool                    bfCheckIfRetreated          (int                        iCombatGroupIndex);
              void                    vfFinishCombat              (ALife::ECombatResult       tCombatResult);
+     IC      void                    vfBuildCombatPartition      ();
+     IC      void                    vfCollectCombatPairs        ();
  
  public:
                                      CALifeCombatManager         (xrServer *server, LPCSTR section);
@@ -7,10 +7,53 @@
  
  #pragma once
  
+ #include "alife_schedule_registry.h"
+ #include "ai_space.h"
+ 
  IC  ALife::ECombatType      CALifeCombatManager::combat_type    () const
  {
      return              (m_combat_type);
  }
+ 
+ IC  bool CALifeCombatManager::CCombatFilter::operator() (CSE_ALifeSchedulable *tpALifeSchedulable1, CSE_ALifeSchedulable *tpALifeSchedulable2) const
+ {
+     if (!tpALifeSchedulable1->bfActive() || !tpALifeSchedulable2->bfActive())
+         return                      (false);
+ 
+     CSE_ALifeMonsterAbstract        *l_tpALifeMonsterAbstract1 = smart_cast<CSE_ALifeMonsterAbstract*>(tpALifeSchedulable1);
+     CSE_ALifeMonsterAbstract        *l_tpALifeMonsterAbstract2 = smart_cast<CSE_ALifeMonsterAbstract*>(tpALifeSchedulable2);
+ 
+     // anomalies do not interact with each other
+     if (!l_tpALifeMonsterAbstract1 && !l_tpALifeMonsterAbstract2)
+         return                      (false);
+ 
+     // monsters fight only enemies, anomalies affect everybody
+     if (l_tpALifeMonsterAbstract1 && l_tpALifeMonsterAbstract2)
+         return                      (ALife::eRelationTypeEnemy == m_manager->relation_type(l_tpALifeMonsterAbstract1,l_tpALifeMonsterAbstract2));
+ 
+     return                          (true);
+ }
+ 
+ IC  void CALifeCombatManager::vfBuildCombatPartition   ()
+ {
+     m_combat_partition.clear        ();
+ 
+     CALifeScheduleRegistry::_REGISTRY::const_iterator   I = scheduled().objects().begin();
+     CALifeScheduleRegistry::_REGISTRY::const_iterator   E = scheduled().objects().end();
+     for ( ; I != E; ++I) {
+         CSE_ALifeDynamicObject      *l_tpALifeDynamicObject = smart_cast<CSE_ALifeDynamicObject*>((*I).second->base());
+         VERIFY                      (l_tpALifeDynamicObject);
+         m_combat_partition.add      ((*I).second,l_tpALifeDynamicObject->m_tGraphID);
+     }
+ 
+     m_combat_partition.build        (ai().game_graph().header().vertex_count());
+ }
+ 
+ IC  void CALifeCombatManager::vfCollectCombatPairs     ()
+ {
+     m_combat_pairs.clear            ();
+     m_combat_partition.collect_pairs(ai().game_graph(),0,ai().game_graph().header().vertex_count(),CCombatFilter(this),m_combat_pairs);
+ }
 
 
 
@@ -0,0 +1,52 @@
+ //  Module      : alife_combat_partition.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife combat partition of schedulable objects by game vertices
+ 
+ #pragma once
+ 
+ class CSE_ALifeSchedulable;
+ class CGameGraph;
+ 
+ // Once per ALife tick the schedulable objects are bucketed by their game vertex
+ // (counting sort into one contiguous array), then candidate pairs are produced
+ // from every bucket and the buckets of its neighbour vertices, rejected early by
+ // a filter (relation type, activity) before the expensive detection checks.
+ // Ranges of vertices touch only their own output, so they may be collected in parallel;
+ // the encounters themselves are resolved sequentially.
+ 
+ class CALifeCombatPartition {
+ public:
+     struct CCandidate {
+         CSE_ALifeSchedulable        *m_object;
+         ALife::_GRAPH_ID            m_game_vertex_id;
+     };
+ 
+     typedef std::pair<CSE_ALifeSchedulable*,CSE_ALifeSchedulable*>  CPair;
+     typedef xr_vector<CCandidate>   CANDIDATES;
+     typedef xr_vector<CPair>        PAIRS;
+ 
+ protected:
+     CANDIDATES                      m_candidates;   // sorted by game vertex
+     xr_vector<u32>                  m_offsets;      // game vertex -> first candidate, vertex_count + 1 entries
+     CANDIDATES                      m_temp;
+ 
+ protected:
+     template <typename _iterator_type>
+     IC  static  bool                visited                 (const CGameGraph &graph, u32 vertex_id, const _iterator_type &edge, u32 neighbour_id);
+ 
+ public:
+     IC      void                    clear                   ();
+     IC      void                    add                     (CSE_ALifeSchedulable *object, ALife::_GRAPH_ID game_vertex_id);
+     IC      void                    build                   (u32 game_vertex_count);
+     IC      u32                     count                   (ALife::_GRAPH_ID game_vertex_id) const;
+     IC      const CCandidate        *objects                (ALife::_GRAPH_ID game_vertex_id) const;
+     template <typename _filter_type>
+     IC      void                    collect_pairs           (const CGameGraph &graph, u32 start_vertex_id, u32 finish_vertex_id, const _filter_type &filter, PAIRS &pairs);
+ };
+ 
+ #include "alife_combat_partition_inline.h"
+
+
+
+
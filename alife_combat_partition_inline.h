@@ -0,0 +1,125 @@
+ //  Module      : alife_combat_partition_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife combat partition of schedulable objects by game vertices inline functions
+ 
+ #pragma once
+ 
+ #include "game_graph.h"
+ 
+ IC  void CALifeCombatPartition::clear               ()
+ {
+     m_candidates.clear      ();
+     m_offsets.clear         ();
+ }
+ 
+ IC  void CALifeCombatPartition::add                 (CSE_ALifeSchedulable *object, ALife::_GRAPH_ID game_vertex_id)
+ {
+     m_candidates.push_back  (CCandidate());
+     m_candidates.back().m_object            = object;
+     m_candidates.back().m_game_vertex_id    = game_vertex_id;
+ }
+ 
+ IC  void CALifeCombatPartition::build               (u32 game_vertex_count)
+ {
+     m_offsets.assign        (game_vertex_count + 1,0);
+ 
+     CANDIDATES::const_iterator  I = m_candidates.begin();
+     CANDIDATES::const_iterator  E = m_candidates.end();
+     for ( ; I != E; ++I) {
+         VERIFY              ((*I).m_game_vertex_id < game_vertex_count);
+         ++m_offsets[(*I).m_game_vertex_id + 1];
+     }
+ 
+     for (u32 i=1; i<=game_vertex_count; ++i)
+         m_offsets[i]        += m_offsets[i - 1];
+ 
+     m_temp.resize           (m_candidates.size());
+     for (I = m_candidates.begin(); I != E; ++I)
+         m_temp[m_offsets[(*I).m_game_vertex_id]++] = *I;
+ 
+     // shift offsets back to the bucket starts
+     for (u32 i=game_vertex_count; i; --i)
+         m_offsets[i]        = m_offsets[i - 1];
+     m_offsets[0]            = 0;
+ 
+     m_candidates.swap       (m_temp);
+ }
+ 
+ IC  u32 CALifeCombatPartition::count                (ALife::_GRAPH_ID game_vertex_id) const
+ {
+     VERIFY                  (u32(game_vertex_id) + 1 < m_offsets.size());
+     return                  (m_offsets[game_vertex_id + 1] - m_offsets[game_vertex_id]);
+ }
+ 
+ IC  const CALifeCombatPartition::CCandidate *CALifeCombatPartition::objects(ALife::_GRAPH_ID game_vertex_id) const
+ {
+     VERIFY                  (u32(game_vertex_id) + 1 < m_offsets.size());
+     return                  (&*m_candidates.begin() + m_offsets[game_vertex_id]);
+ }
+ 
+ // the game graph does not guarantee symmetric or unique edges : a pair of vertices is
+ // visited from its first edge, by the lower vertex if both vertices list it
+ template <typename _iterator_type>
+ IC  bool CALifeCombatPartition::visited             (const CGameGraph &graph, u32 vertex_id, const _iterator_type &edge, u32 neighbour_id)
+ {
+     // self loops are handled inside the vertex
+     if (neighbour_id == vertex_id)
+         return              (true);
+ 
+     CGameGraph::const_iterator  I, E;
+     graph.begin             (vertex_id,I,E);
+     for ( ; I != edge; ++I)
+         if (graph.value(vertex_id,I) == neighbour_id)
+             return          (true);
+ 
+     if (neighbour_id > vertex_id)
+         return              (false);
+ 
+     graph.begin             (neighbour_id,I,E);
+     for ( ; I != E; ++I)
+         if (graph.value(neighbour_id,I) == vertex_id)
+             return          (true);
+ 
+     return                  (false);
+ }
+ 
+ template <typename _filter_type>
+ IC  void CALifeCombatPartition::collect_pairs       (const CGameGraph &graph, u32 start_vertex_id, u32 finish_vertex_id, const _filter_type &filter, PAIRS &pairs)
+ {
+     for (u32 vertex_id = start_vertex_id; vertex_id < finish_vertex_id; ++vertex_id) {
+         u32                 vertex_count = count(ALife::_GRAPH_ID(vertex_id));
+         if (!vertex_count)
+             continue;
+ 
+         const CCandidate    *vertex_objects = objects(ALife::_GRAPH_ID(vertex_id));
+ 
+         // inside the vertex
+         for (u32 i=0; i<vertex_count; ++i)
+             for (u32 j=i + 1; j<vertex_count; ++j) {
+                 if (filter(vertex_objects[i].m_object,vertex_objects[j].m_object))
+                     pairs.push_back(CPair(vertex_objects[i].m_object,vertex_objects[j].m_object));
+             }
+ 
+         // with the neighbour vertices, each pair of vertices is visited once
+         CGameGraph::const_iterator  I, E;
+         graph.begin         (vertex_id,I,E);
+         for ( ; I != E; ++I) {
+             u32             neighbour_id = graph.value(vertex_id,I);
+             if (visited(graph,vertex_id,I,neighbour_id))
+                 continue;
+ 
+             u32             neighbour_count = count(ALife::_GRAPH_ID(neighbour_id));
+             const CCandidate    *neighbour_objects = objects(ALife::_GRAPH_ID(neighbour_id));
+             for (u32 i=0; i<vertex_count; ++i)
+                 for (u32 j=0; j<neighbour_count; ++j) {
+                     if (filter(vertex_objects[i].m_object,neighbour_objects[j].m_object))
+                         pairs.push_back(CPair(vertex_objects[i].m_object,neighbour_objects[j].m_object));
+                 }
+         }
+     }
+ }
+
+
+
+
@@ -8,6 +8,7 @@
  #pragma once
  
  #include "alife_simulator_base.h"
+ #include "alife_trade_matcher.h"
  
  class CSE_ALifeSchedulable;
  class CSE_ALifeHumanAbstract;
@@ -40,6 +41,11 @@
  
      ALife::SSumStackCell                m_tpStack1[MAX_STACK_DEPTH];
      ALife::SSumStackCell                m_tpStack2[MAX_STACK_DEPTH];
+ 
+     // subset sums tables of both traders, built once per trade and shared by all the balance checks
+     CALifeTradeMatcher                  m_tMatcher1;
+     CALifeTradeMatcher                  m_tMatcher2;
+     ALife::INT_VECTOR                   m_tpPrices;
  protected:
              u32         dwfComputeItemCost              (ALife::ITEM_P_VECTOR       &tpItemVector);
              void        vfRunFunctionByIndex            (CSE_ALifeHumanAbstract     *tpALifeHumanAbstract,      ALife::OBJECT_VECTOR            &tpBlockedItems,                ALife::ITEM_P_VECTOR    &tpItems,                   int                     i,                      int                     &j);
@@ -51,6 +57,8 @@
              void        vfFillTraderVector              (CSE_ALifeHumanAbstract     *tpALifeHumanAbstract,      int                             iItemCount,                     ALife::ITEM_P_VECTOR    &tpItemVector);
              void        vfGenerateSums                  (ALife::ITEM_P_VECTOR       &tpTrader,                  ALife::INT_VECTOR               &tpSums);
              bool        bfGetItemIndexes                (ALife::ITEM_P_VECTOR       &tpTrader,                  int                             iSum1,                          ALife::INT_VECTOR       &tpIndexes,                 ALife::SSumStackCell            *tpStack,               int                     iStartI,                    int             iStackPointer);
+     IC      void        vfGenerateSums                  (ALife::ITEM_P_VECTOR       &tpTrader,                  CALifeTradeMatcher              &tMatcher,                      int                     iMaxSum,                    ALife::INT_VECTOR       &tpSums);
+     IC      bool        bfGetItemIndexes                (const CALifeTradeMatcher   &tMatcher,                  int                             iSum,                           ALife::INT_VECTOR       &tpIndexes);
              bool        bfCheckForInventoryCapacity     (CSE_ALifeHumanAbstract     *tpALifeHumanAbstract1,     ALife::ITEM_P_VECTOR            &tpTrader1,                     ALife::INT_VECTOR       &tpIndexes1,                CSE_ALifeHumanAbstract  *tpALifeHumanAbstract2, ALife::ITEM_P_VECTOR            &tpTrader2,                 ALife::INT_VECTOR       &tpIndexes2);
              bool        bfCheckForInventoryCapacity     (CSE_ALifeHumanAbstract     *tpALifeHumanAbstract1,     ALife::ITEM_P_VECTOR            &tpTrader1,                     int             iSum1,                      int                     iMoney1,                CSE_ALifeHumanAbstract  *tpALifeHumanAbstract2,             ALife::ITEM_P_VECTOR    &tpTrader2,     int         iSum2,      int iMoney2, int iBalance);
              bool        bfCheckForTrade                 (CSE_ALifeHumanAbstract     *tpALifeHumanAbstract1,     ALife::ITEM_P_VECTOR            &tpTrader1,                     ALife::INT_VECTOR       &tpSums1,                   int                     iMoney1,                CSE_ALifeHumanAbstract  *tpALifeHumanAbstract2,     ALife::ITEM_P_VECTOR    &tpTrader2,     ALife::INT_VECTOR   &tpSums2,   int iMoney2, int iBalance);
@@ -73,6 +81,8 @@
      virtual             ~CALifeCommunicationManager     ();
              void        communicate_with_customer       (CSE_ALifeHumanAbstract     *tpALifeHumanAbstract,      CSE_ALifeTrader         *tpALifeTrader);
  };
+ 
+ #include "alife_communication_manager_inline.h"
 
 
 
@@ -7,6 +7,22 @@
  
  #pragma once
  
+ #include "xrServer_Objects_ALife_Items.h"
+ 
+ IC  void CALifeCommunicationManager::vfGenerateSums     (ALife::ITEM_P_VECTOR &tpTrader, CALifeTradeMatcher &tMatcher, int iMaxSum, ALife::INT_VECTOR &tpSums)
+ {
+     m_tpPrices.resize               (tpTrader.size());
+     for (u32 i=0, n=u32(tpTrader.size()); i<n; ++i)
+         m_tpPrices[i]               = int(tpTrader[i]->m_dwCost);
+ 
+     tMatcher.init                   (m_tpPrices,iMaxSum);
+     tMatcher.sums                   (tpSums);
+ }
+ 
+ IC  bool CALifeCommunicationManager::bfGetItemIndexes   (const CALifeTradeMatcher &tMatcher, int iSum, ALife::INT_VECTOR &tpIndexes)
+ {
+     return                          (tMatcher.indexes(iSum,tpIndexes));
+ }
 
 
 
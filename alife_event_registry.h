@@ -8,14 +8,15 @@
  #pragma once
  
  #include "alife_event.h"
- #include "object_broker.h"
+ #include "alife_time_buckets.h"
  
  class CALifeEventRegistry {
+ public:
+     typedef CALifeTimeBuckets<CALifeEvent>  EVENTS;
+ 
  protected:
      template <typename _predicate>
-     struct CEventLoader : public object_loader::detail::CEmptyPredicate {
-         using object_loader::detail::CEmptyPredicate::operator();
- 
+     struct CEventLoader {
          const _predicate            &m_predicate;
  
          IC                          CEventLoader    (const _predicate &predicate) :
@@ -23,37 +24,35 @@
          {
          }
  
-         template <typename T1, typename T2>
-         IC  bool operator()	(T1 &data, const T2 &value, bool first) const {return(!first);}
-         
-         template <typename T1, typename T2>
-         IC  void operator()	(std::pair<T1,T2> &data) const
-         {
-             const_cast<object_type_traits::remove_const<T1>::type&>(data.first) = data.second->m_tEventID;
-             m_predicate             (data.second);
-         }
- 
-         IC CEventLoader<_predicate> &operator=		(const CEventLoader<_predicate> &T)
+         IC  CALifeEvent             *operator()     (IReader &stream, EVENTS::_id &id, ALife::_TIME_ID &time) const
          {
-             *this                   = T;
-             return                  (*this);
+             CALifeEvent             *event = xr_new<CALifeEvent>();
+             event->load             (stream);
+             id                      = event->m_tEventID;
+             time                    = event->m_tTimeID;
+             m_predicate             (event);
+             return                  (event);
          }
      };
  
  protected:
      ALife::_EVENT_ID                m_id;
-     ALife::EVENT_MAP                m_events;
+     EVENTS                          m_events;
+     xr_vector<ALife::_EVENT_ID>     m_expired_ids;
  
  public:
      IC                              CALifeEventRegistry     (LPCSTR section);
      virtual                         ~CALifeEventRegistry    ();
      virtual void                    save                    (IWriter &memory_stream);
      template <typename _predicate>
-     IC      void                    load                    (IReader &file_stream, const _predicate &predicate);
+     IC      void                    load                    (IReader &file_stream, const _predicate &predicate, u32 version = ALIFE_VERSION);
      IC      void                    add                     (CALifeEvent    *event);
      IC      void                    remove                  (const ALife::_EVENT_ID &event_id, bool no_assert = false);
      IC      CALifeEvent             *event                  (const ALife::_EVENT_ID &event_id, bool no_assert = false) const;
-     IC      const ALife::EVENT_MAP  &events                 () const;
+     IC      const EVENTS            &events                 () const;
+     template <typename _objects_type>
+     IC      void                    expire                  (const ALife::_TIME_ID &time, const _objects_type &objects);
+     IC      void                    destroy_expired         ();
  };
  
  #include "alife_event_registry_inline.h"
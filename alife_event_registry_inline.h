@@ -7,52 +7,89 @@
  
  #pragma once
  
+ #include "xrServer_Objects_ALife_Monsters.h"
+ 
  IC  CALifeEventRegistry::CALifeEventRegistry            (LPCSTR section)
  {
      m_id                            = 0;
+     if (pSettings->line_exist(section,"event_bucket_span") && pSettings->line_exist(section,"event_bucket_count"))
+         m_events.setup              (ALife::_TIME_ID(pSettings->r_u32(section,"event_bucket_span"))*1000,pSettings->r_u32(section,"event_bucket_count"));
  }
  
- IC  const ALife::EVENT_MAP &CALifeEventRegistry::events () const
+ IC  const CALifeEventRegistry::EVENTS &CALifeEventRegistry::events  () const
  {
      return                          (m_events);
  }
  
  IC  CALifeEvent *CALifeEventRegistry::event             (const ALife::_EVENT_ID &event_id, bool no_assert) const
  {
-     ALife::EVENT_MAP::const_iterator    I = events().find(event_id);
-     if (events().end() == I) {
-         R_ASSERT2                   (no_assert,"Specified event hasn't been found in the Event registry!");
-         return                      (0);
-     }
-     return                          ((*I).second);
+     CALifeEvent                     *event = m_events.object(event_id);
+     R_ASSERT2                       (event || no_assert,"Specified event hasn't been found in the Event registry!");
+     return                          (event);
  }
  
  IC  void CALifeEventRegistry::add                       (CALifeEvent *event)
  {
-     if (m_events.find(event->m_tEventID) != m_events.end()) {
-         R_ASSERT2                   ((*(m_events.find(event->m_tEventID))).second == event,"The specified event is already presented in the Event Registry!");
-         R_ASSERT2                   ((*(m_events.find(event->m_tEventID))).second != event,"Event with the specified ID is already presented in the Event Registry!");
-     }
-     m_events.insert             (mk_pair(event->m_tEventID = m_id++,event));
+     event->m_tEventID               = m_id++;
+     m_events.add                    (event->m_tEventID,event->m_tTimeID,event);
  }
  
  IC  void CALifeEventRegistry::remove                    (const ALife::_EVENT_ID &event_id, bool no_assert)
  {
-     ALife::EVENT_MAP::iterator      I = m_events.find(event_id);
-     if (m_events.end() == I) {
+     if (!m_events.remove(event_id))
          R_ASSERT2                   (no_assert,"The specified event is not found in the Event Registry!");
+ }
+ 
+ // personal events of the traders refer to the events by id, the ones referring
+ // to the expired events are destroyed, so event() is never asked for an expired one
+ template <typename _objects_type>
+ IC  void CALifeEventRegistry::expire                    (const ALife::_TIME_ID &time, const _objects_type &objects)
+ {
+     m_events.expire                 (time);
+     if (m_events.expired().empty())
          return;
+ 
+     m_expired_ids.clear             ();
+     EVENTS::OBJECTS::const_iterator I = m_events.expired().begin();
+     EVENTS::OBJECTS::const_iterator E = m_events.expired().end();
+     for ( ; I != E; ++I)
+         m_expired_ids.push_back     ((*I)->m_tEventID);
+     std::sort                       (m_expired_ids.begin(),m_expired_ids.end());
+ 
+     typename _objects_type::const_iterator  i = objects.begin();
+     typename _objects_type::const_iterator  e = objects.end();
+     for ( ; i != e; ++i) {
+         CSE_ALifeTraderAbstract     *trader = smart_cast<CSE_ALifeTraderAbstract*>((*i).second);
+         if (!trader)
+             continue;
+ 
+         ALife::PERSONAL_EVENT_P_IT  J = trader->m_tpEvents.begin();
+         while (J != trader->m_tpEvents.end()) {
+             if (!std::binary_search(m_expired_ids.begin(),m_expired_ids.end(),(*J)->m_tEventID)) {
+                 ++J;
+                 continue;
+             }
+             xr_delete               (*J);
+             J                       = trader->m_tpEvents.erase(J);
+         }
      }
-     m_events.erase                  (I);
+ }
+ 
+ IC  void CALifeEventRegistry::destroy_expired           ()
+ {
+     m_events.destroy_expired        ();
  }
  
  template <typename _predicate>
- void CALifeEventRegistry::load                          (IReader &file_stream, const _predicate &predicate)
+ void CALifeEventRegistry::load                          (IReader &file_stream, const _predicate &predicate, u32 version)
  {
      Msg                         ("* Loading events...");
      R_ASSERT2                   (file_stream.find_chunk(EVENT_CHUNK_DATA),"Can't find chunk EVENT_CHUNK_DATA!");
      file_stream.r               (&m_id,sizeof(m_id));
-     load_data                   (m_events,file_stream,CEventLoader<_predicate>(predicate));
+     if (version < 0x0002)
+         m_events.load_flat      (file_stream,CEventLoader<_predicate>(predicate));
+     else
+         m_events.load           (file_stream,CEventLoader<_predicate>(predicate));
  }
 
 
@@ -10,13 +10,14 @@
  #include "xrServer_Objects_ALife_All.h"
  #include "alife_level_registry.h"
  #include "alife_event.h"
+ #include "alife_movement_kernel.h"
  
  class CSE_ALifeCreatureActor;
  
  class CALifeGraphRegistry {
  public:
-     typedef CSafeMapIterator<ALife::_OBJECT_ID,CSE_ALifeDynamicObject>  OBJECT_REGISTRY;
-     typedef CSafeMapIterator<ALife::_EVENT_ID,CALifeEvent>              EVENT_REGISTRY;
+     typedef CSafeFlatMapIterator<ALife::_OBJECT_ID,CSE_ALifeDynamicObject>  OBJECT_REGISTRY;
+     typedef CSafeFlatMapIterator<ALife::_EVENT_ID,CALifeEvent>              EVENT_REGISTRY;
  
  public:
      class CGraphPointInfo {
@@ -53,6 +54,7 @@
      u64                                 m_process_time;
      shared_str                              *m_server_command_line;
      xr_vector<CSE_ALifeDynamicObject*>  m_temp;
+     CALifeMovementKernel                m_movement;
  
  protected:
              void                        setup_current_level     ();
@@ -72,6 +74,8 @@
      IC      void                        remove                  (CALifeEvent                *event,     ALife::_GRAPH_ID        game_vertex_id);
      IC      void                        change                  (CSE_ALifeDynamicObject     *object,    ALife::_GRAPH_ID        game_vertex_id, ALife::_GRAPH_ID    next_game_vertex_id);
      IC      void                        change                  (CALifeEvent                *event,     ALife::_GRAPH_ID        game_vertex_id, ALife::_GRAPH_ID    next_game_vertex_id);
+     IC      void                        update_movement         (float                      time_delta);
+     IC      CALifeMovementKernel        &movement               ();
      IC      CALifeLevelRegistry         &level                  () const;
      IC      void                        set_process_time        (const u64 &process_time);
      IC      CSE_ALifeCreatureActor      *actor                  () const;
@@ -97,6 +97,23 @@
          }
  }
  
+ IC  void CALifeGraphRegistry::update_movement   (float time_delta)
+ {
+     m_movement.update           (time_delta);
+ 
+     CALifeMovementKernel::OBJECTS::const_iterator   I = m_movement.crossed().begin();
+     CALifeMovementKernel::OBJECTS::const_iterator   E = m_movement.crossed().end();
+     for ( ; I != E; ++I) {
+         (*I)->m_tPrevGraphID    = (*I)->m_tGraphID;
+         change                  (*I,(*I)->m_tGraphID,(*I)->m_tNextGraphID);
+     }
+ }
+ 
+ IC  CALifeMovementKernel &CALifeGraphRegistry::movement ()
+ {
+     return                      (m_movement);
+ }
+ 
  IC  void CALifeGraphRegistry::set_process_time  (const u64 &process_time)
  {
      m_process_time              = process_time;
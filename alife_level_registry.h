@@ -7,15 +7,15 @@
  
  #pragma once
  
- #include "safe_map_iterator.h"
+ #include "safe_flat_map_iterator.h"
  #include "xrServer_Objects_ALife.h"
  #include "game_graph.h"
  
  class CSE_ALifeDynamicObject;
  
- class CALifeLevelRegistry : public CSafeMapIterator<ALife::_OBJECT_ID,CSE_ALifeDynamicObject> {
+ class CALifeLevelRegistry : public CSafeFlatMapIterator<ALife::_OBJECT_ID,CSE_ALifeDynamicObject> {
  protected:
-     typedef CSafeMapIterator<ALife::_OBJECT_ID,CSE_ALifeDynamicObject> inherited;
+     typedef CSafeFlatMapIterator<ALife::_OBJECT_ID,CSE_ALifeDynamicObject> inherited;
  
  protected:
      ALife::_LEVEL_ID                m_level_id;
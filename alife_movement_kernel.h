@@ -0,0 +1,58 @@
+ //  Module      : alife_movement_kernel.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife offline movement kernel
+ 
+ #pragma once
+ 
+ class CSE_ALifeMonsterAbstract;
+ 
+ // Edge progress of the offline travellers is kept in parallel arrays (distance
+ // travelled, edge length, speed) and advanced for all of them in one pass per
+ // ALife tick. Only the travellers which reached the end of their edge are reported,
+ // so the graph registry and the objects themselves are touched for them only.
+ // A crossed traveller keeps the distance it overshot the vertex by as the progress
+ // on its next edge and stands still until that edge is set.
+ // Objects hold stale progress while registered, call synchronize before reading it.
+ 
+ class CALifeMovementKernel {
+ public:
+     typedef xr_vector<CSE_ALifeMonsterAbstract*>    OBJECTS;
+ 
+ protected:
+     enum {
+         INVALID_SLOT                = u32(-1),
+     };
+ 
+ protected:
+     OBJECTS                         m_objects;
+     xr_vector<float>                m_distance_from;    // travelled along the current edge
+     xr_vector<float>                m_distance_to;      // edge length, flt_max when standing
+     xr_vector<float>                m_speed;
+     xr_vector<float>                m_velocity;         // m_speed when moving, 0 when standing
+     xr_vector<u32>                  m_slots;            // object id -> index in the arrays
+     OBJECTS                         m_crossed;
+ 
+ protected:
+     IC      u32                     slot                    (const CSE_ALifeMonsterAbstract *object) const;
+     IC      void                    write_back              (u32 index);
+ 
+ public:
+     IC      void                    clear                   ();
+     IC      void                    add                     (CSE_ALifeMonsterAbstract *object);
+     IC      void                    remove                  (CSE_ALifeMonsterAbstract *object);
+     IC      bool                    registered              (const CSE_ALifeMonsterAbstract *object) const;
+     IC      void                    set_edge                (CSE_ALifeMonsterAbstract *object);
+     IC      void                    set_speed               (CSE_ALifeMonsterAbstract *object, float speed);
+     IC      void                    synchronize             (CSE_ALifeMonsterAbstract *object);
+     IC      void                    synchronize             ();
+     IC      void                    update                  (float time_delta);
+     IC      const OBJECTS           &crossed                () const;
+     IC      u32                     count                   () const;
+ };
+ 
+ #include "alife_movement_kernel_inline.h"
+
+
+
+
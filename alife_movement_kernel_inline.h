@@ -0,0 +1,156 @@
+ //  Module      : alife_movement_kernel_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife offline movement kernel inline functions
+ 
+ #pragma once
+ 
+ #include "xrServer_Objects_ALife_Monsters.h"
+ 
+ IC  u32 CALifeMovementKernel::slot                  (const CSE_ALifeMonsterAbstract *object) const
+ {
+     if (object->ID >= m_slots.size())
+         return              (u32(INVALID_SLOT));
+     return                  (m_slots[object->ID]);
+ }
+ 
+ IC  void CALifeMovementKernel::write_back           (u32 index)
+ {
+     CSE_ALifeMonsterAbstract    *object = m_objects[index];
+     object->m_fDistanceFromPoint    = m_distance_from[index];
+     object->m_fCurSpeed             = m_speed[index];
+ }
+ 
+ IC  void CALifeMovementKernel::clear                ()
+ {
+     m_objects.clear         ();
+     m_distance_from.clear   ();
+     m_distance_to.clear     ();
+     m_speed.clear           ();
+     m_velocity.clear        ();
+     m_slots.clear           ();
+     m_crossed.clear         ();
+ }
+ 
+ IC  void CALifeMovementKernel::add                  (CSE_ALifeMonsterAbstract *object)
+ {
+     VERIFY                  (!registered(object));
+     if (object->ID >= m_slots.size())
+         m_slots.resize      (object->ID + 1,u32(INVALID_SLOT));
+ 
+     m_slots[object->ID]     = u32(m_objects.size());
+     m_objects.push_back     (object);
+     m_distance_from.push_back(object->m_fDistanceFromPoint);
+     m_distance_to.push_back (flt_max);
+     m_speed.push_back       (object->m_fCurSpeed);
+     m_velocity.push_back    (0.f);
+     set_edge                (object);
+ }
+ 
+ IC  void CALifeMovementKernel::remove               (CSE_ALifeMonsterAbstract *object)
+ {
+     u32                     index = slot(object);
+     VERIFY                  (index != INVALID_SLOT);
+     write_back              (index);
+ 
+     u32                     last = u32(m_objects.size()) - 1;
+     if (index != last) {
+         m_objects[index]        = m_objects[last];
+         m_distance_from[index]  = m_distance_from[last];
+         m_distance_to[index]    = m_distance_to[last];
+         m_speed[index]          = m_speed[last];
+         m_velocity[index]       = m_velocity[last];
+         m_slots[m_objects[index]->ID]   = index;
+     }
+ 
+     m_objects.pop_back      ();
+     m_distance_from.pop_back();
+     m_distance_to.pop_back  ();
+     m_speed.pop_back        ();
+     m_velocity.pop_back     ();
+     m_slots[object->ID]     = u32(INVALID_SLOT);
+ }
+ 
+ IC  bool CALifeMovementKernel::registered           (const CSE_ALifeMonsterAbstract *object) const
+ {
+     return                  (slot(object) != INVALID_SLOT);
+ }
+ 
+ IC  void CALifeMovementKernel::set_edge             (CSE_ALifeMonsterAbstract *object)
+ {
+     u32                     index = slot(object);
+     VERIFY                  (index != INVALID_SLOT);
+     m_distance_from[index]  = object->m_fDistanceFromPoint;
+     if (object->m_tNextGraphID == object->m_tGraphID) {
+         m_distance_to[index]= flt_max;
+         m_velocity[index]   = 0.f;
+     }
+     else {
+         m_distance_to[index]= object->m_fDistanceToPoint;
+         m_velocity[index]   = m_speed[index];
+     }
+ }
+ 
+ IC  void CALifeMovementKernel::set_speed            (CSE_ALifeMonsterAbstract *object, float speed)
+ {
+     u32                     index = slot(object);
+     VERIFY                  (index != INVALID_SLOT);
+     m_speed[index]          = speed;
+     if (m_distance_to[index] != flt_max)
+         m_velocity[index]   = speed;
+ }
+ 
+ IC  void CALifeMovementKernel::synchronize          (CSE_ALifeMonsterAbstract *object)
+ {
+     u32                     index = slot(object);
+     if (index != INVALID_SLOT)
+         write_back          (index);
+ }
+ 
+ IC  void CALifeMovementKernel::synchronize          ()
+ {
+     for (u32 i=0, n=u32(m_objects.size()); i<n; ++i)
+         write_back          (i);
+ }
+ 
+ IC  void CALifeMovementKernel::update               (float time_delta)
+ {
+     m_crossed.clear         ();
+     u32                     n = u32(m_objects.size());
+     if (!n)
+         return;
+ 
+     // no branches and no indirections, the compiler vectorises this loop
+     float                   *distance_from = &*m_distance_from.begin();
+     const float             *velocity = &*m_velocity.begin();
+     for (u32 i=0; i<n; ++i)
+         distance_from[i]    += velocity[i]*time_delta;
+ 
+     const float             *distance_to = &*m_distance_to.begin();
+     for (u32 i=0; i<n; ++i) {
+         if (distance_from[i] < distance_to[i])
+             continue;
+ 
+         // the traveller stands at the vertex until the new edge is set,
+         // the overshoot is kept as the progress along that edge
+         distance_from[i]    -= distance_to[i];
+         m_distance_to[i]    = flt_max;
+         m_velocity[i]       = 0.f;
+         write_back          (i);
+         m_crossed.push_back (m_objects[i]);
+     }
+ }
+ 
+ IC  const CALifeMovementKernel::OBJECTS &CALifeMovementKernel::crossed() const
+ {
+     return                  (m_crossed);
+ }
+ 
+ IC  u32 CALifeMovementKernel::count                 () const
+ {
+     return                  (u32(m_objects.size()));
+ }
+
+
+
+
@@ -9,10 +9,32 @@
  
  #include "alife_news.h"
  #include "alife_space.h"
+ #include "alife_time_buckets.h"
  
  class CALifeNewsRegistry {
+ public:
+     typedef CALifeTimeBuckets<CALifeNews>   NEWS;
+ 
+ protected:
+     struct CNewsLoader {
+         bool                            m_keyed;    // map layout before ALIFE_VERSION 0x0002, the id precedes every news
+ 
+         IC                              CNewsLoader (bool keyed) : m_keyed(keyed) {}
+ 
+         IC  CALifeNews                  *operator() (IReader &stream, NEWS::_id &id, ALife::_TIME_ID &time) const
+         {
+             if (m_keyed)
+                 stream.r_u32            ();
+             CALifeNews                  *news = xr_new<CALifeNews>();
+             news->load                  (stream);
+             id                          = news->m_news_id;
+             time                        = news->m_game_time;
+             return                      (news);
+         }
+     };
+ 
  protected:
-     ALife::NEWS_REGISTRY                m_news;
+     NEWS                                m_news;
      ALife::_NEWS_ID                     m_last_id;
  
  public:
@@ -20,11 +42,13 @@
      virtual                             ~CALifeNewsRegistry ();
      virtual void                        save                (IWriter &memory_stream);
      virtual void                        load                (IReader &file_stream);
+     IC      void                        load                (IReader &file_stream, u32 version);
              void                        clear               ();
      IC      ALife::_NEWS_ID             add                 (const CALifeNews &news);
      IC      void                        remove              (const ALife::_NEWS_ID &news_id);
-     IC      const ALife::NEWS_REGISTRY  &news               () const;
+     IC      const NEWS                  &news               () const;
      IC      const CALifeNews            *news               (const ALife::_NEWS_ID &news_id) const;
+     IC      void                        expire              (const ALife::_TIME_ID &time);
  };
  
  #include "alife_news_registry_inline.h"
@@ -11,28 +11,41 @@
  {
      CALifeNews                      *_news = xr_new<CALifeNews>(news);
      _news->m_news_id                = m_last_id++;
-     m_news.insert                   (std::make_pair(_news->m_news_id,_news));
+     m_news.add                      (_news->m_news_id,_news->m_game_time,_news);
      return                          (_news->m_news_id);
  }
  
  IC  void CALifeNewsRegistry::remove     (const ALife::_NEWS_ID &news_id)
  {
-     ALife::NEWS_REGISTRY::iterator  I = m_news.find(news_id);
-     VERIFY                          (news().end() != I);
-     m_news.erase                    (I);
+     CALifeNews                      *_news = m_news.remove(news_id);
+     VERIFY                          (_news);
  }
  
- IC  const ALife::NEWS_REGISTRY &CALifeNewsRegistry::news    () const
+ IC  const CALifeNewsRegistry::NEWS &CALifeNewsRegistry::news    () const
  {
      return                          (m_news);
  }
  
  IC  const CALifeNews *CALifeNewsRegistry::news  (const ALife::_NEWS_ID &news_id) const
  {
-     ALife::NEWS_REGISTRY::const_iterator    I = news().find(news_id);
-     if (news().end() == I)
-         return                      (0);
-     return                          ((*I).second);
+     return                          (m_news.object(news_id));
+ }
+ 
+ // load(IReader&) forwards here with the version of the save header
+ IC  void CALifeNewsRegistry::load       (IReader &file_stream, u32 version)
+ {
+     if (version < 0x0002)
+         m_news.load_flat            (file_stream,CNewsLoader(true));
+     else
+         m_news.load                 (file_stream,CNewsLoader(false));
+     m_news.destroy_expired          ();
+ }
+ 
+ IC  void CALifeNewsRegistry::expire     (const ALife::_TIME_ID &time)
+ {
+     // nobody refers to the news by pointer
+     m_news.expire                   (time);
+     m_news.destroy_expired          ();
  }
 
 
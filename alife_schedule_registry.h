@@ -7,10 +7,10 @@
  
  #pragma once
  
- #include "safe_map_iterator.h"
+ #include "safe_flat_map_iterator.h"
  #include "xrServer_Objects_ALife.h"
  
- class CALifeScheduleRegistry : public CSafeMapIterator<ALife::_OBJECT_ID,CSE_ALifeSchedulable> {
+ class CALifeScheduleRegistry : public CSafeFlatMapIterator<ALife::_OBJECT_ID,CSE_ALifeSchedulable> {
  private:
      struct CUpdatePredicate {
          IC  bool    operator()  (_iterator &i, u64 cycle_count, bool) const
@@ -29,7 +29,7 @@
      };
  
  protected:
-     typedef CSafeMapIterator<ALife::_OBJECT_ID,CSE_ALifeSchedulable> inherited;
+     typedef CSafeFlatMapIterator<ALife::_OBJECT_ID,CSE_ALifeSchedulable> inherited;
  
  public:
      virtual                         ~CALifeScheduleRegistry ();
@@ -0,0 +1,62 @@
+ //  Module      : alife_spawn_index.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife spawn index, lazily decoded spawn entries over a mapped file
+ 
+ #pragma once
+ 
+ class CSE_Abstract;
+ 
+ // The spawn file stays mapped, only the chunk headers are walked on open,
+ // so every entry costs an offset and a size until it is asked for.
+ // An entry is decoded on first use and may be released again by the release policy
+ // when it has not been used for a while and nobody holds a pin on it.
+ // The object returned by 'object' is valid until the next 'release_unused' only,
+ // holders that keep it longer pin it and unpin it when done.
+ 
+ class CALifeSpawnIndex {
+ public:
+     struct CEntry {
+         u32                         m_offset;       // from the stream start, 0 - no entry
+         u32                         m_size;
+         CSE_Abstract                *m_object;
+         u32                         m_last_used;
+         u32                         m_pins;
+     };
+ 
+     typedef xr_vector<CEntry>       ENTRIES;
+ 
+ protected:
+     IReader                         *m_file;        // owned, mapped
+     IReader                         *m_stream;      // owned, the chunk with the spawn entries
+     ENTRIES                         m_entries;      // by spawn id
+     u32                             m_entry_count;
+     u32                             m_decoded_count;
+ 
+ public:
+     u32                             m_stat_decoded;
+     u32                             m_stat_released;
+ 
+ public:
+     IC                              CALifeSpawnIndex    ();
+     IC                              ~CALifeSpawnIndex   ();
+     IC      void                    open                (IReader *file, u32 chunk_id);
+     IC      void                    close               ();
+     IC      bool                    valid               (u32 spawn_id) const;
+     IC      u32                     count               () const;
+     IC      u32                     decoded_count       () const;
+     IC      void                    pin                 (u32 spawn_id);
+     IC      void                    unpin               (u32 spawn_id);
+     template <typename _decoder_type>
+     IC      CSE_Abstract            *object             (u32 spawn_id, const _decoder_type &decoder, u32 time);
+     template <typename _destroyer_type>
+     IC      u32                     release_unused      (u32 time, u32 lifetime, const _destroyer_type &destroyer);
+     template <typename _destroyer_type>
+     IC      void                    release_all         (const _destroyer_type &destroyer);
+ };
+ 
+ #include "alife_spawn_index_inline.h"
+
+
+
+
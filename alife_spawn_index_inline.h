@@ -0,0 +1,144 @@
+ //  Module      : alife_spawn_index_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife spawn index, lazily decoded spawn entries over a mapped file inline functions
+ 
+ #pragma once
+ 
+ IC  CALifeSpawnIndex::CALifeSpawnIndex          ()
+ {
+     m_file                  = 0;
+     m_stream                = 0;
+     m_entry_count           = 0;
+     m_decoded_count         = 0;
+     m_stat_decoded          = 0;
+     m_stat_released         = 0;
+ }
+ 
+ IC  CALifeSpawnIndex::~CALifeSpawnIndex         ()
+ {
+     VERIFY                  (!m_decoded_count);
+     close                   ();
+ }
+ 
+ IC  void CALifeSpawnIndex::open                 (IReader *file, u32 chunk_id)
+ {
+     close                   ();
+     m_file                  = file;
+     m_stream                = m_file->open_chunk(chunk_id);
+     R_ASSERT2               (m_stream,"Can't find spawn entries chunk!");
+ 
+     // chunk headers only : id, size, data
+     while (!m_stream->eof()) {
+         u32                 spawn_id = m_stream->r_u32();
+         u32                 size = m_stream->r_u32();
+         VERIFY2             (!(spawn_id & CFS_CompressMark),"Compressed spawn entries are not supported!");
+ 
+         if (spawn_id >= m_entries.size()) {
+             CEntry          empty = {0, 0, 0, 0, 0};
+             m_entries.resize(spawn_id + 1,empty);
+         }
+ 
+         CEntry              &entry = m_entries[spawn_id];
+         VERIFY              (!entry.m_offset);
+         entry.m_offset      = u32(m_stream->tell());
+         entry.m_size        = size;
+         ++m_entry_count;
+         m_stream->advance   (size);
+     }
+ }
+ 
+ IC  void CALifeSpawnIndex::close                ()
+ {
+     VERIFY                  (!m_decoded_count);
+     m_entries.clear         ();
+     m_entry_count           = 0;
+     if (m_stream)
+         m_stream->close     ();
+     m_stream                = 0;
+     xr_delete               (m_file);
+ }
+ 
+ IC  bool CALifeSpawnIndex::valid                (u32 spawn_id) const
+ {
+     return                  ((spawn_id < m_entries.size()) && m_entries[spawn_id].m_offset);
+ }
+ 
+ IC  u32 CALifeSpawnIndex::count                 () const
+ {
+     return                  (m_entry_count);
+ }
+ 
+ IC  u32 CALifeSpawnIndex::decoded_count         () const
+ {
+     return                  (m_decoded_count);
+ }
+ 
+ IC  void CALifeSpawnIndex::pin                  (u32 spawn_id)
+ {
+     VERIFY                  (valid(spawn_id));
+     ++m_entries[spawn_id].m_pins;
+ }
+ 
+ IC  void CALifeSpawnIndex::unpin                (u32 spawn_id)
+ {
+     VERIFY                  (valid(spawn_id));
+     VERIFY2                 (m_entries[spawn_id].m_pins,"Spawn entry is not pinned!");
+     --m_entries[spawn_id].m_pins;
+ }
+ 
+ template <typename _decoder_type>
+ IC  CSE_Abstract *CALifeSpawnIndex::object      (u32 spawn_id, const _decoder_type &decoder, u32 time)
+ {
+     VERIFY                  (valid(spawn_id));
+     CEntry                  &entry = m_entries[spawn_id];
+     entry.m_last_used       = time;
+     if (entry.m_object)
+         return              (entry.m_object);
+ 
+     IReader                 chunk((u8*)m_stream->pointer() - m_stream->tell() + entry.m_offset,entry.m_size);
+     entry.m_object          = decoder(chunk,spawn_id);
+     VERIFY                  (entry.m_object);
+     ++m_decoded_count;
+     ++m_stat_decoded;
+     return                  (entry.m_object);
+ }
+ 
+ template <typename _destroyer_type>
+ IC  u32 CALifeSpawnIndex::release_unused        (u32 time, u32 lifetime, const _destroyer_type &destroyer)
+ {
+     u32                     result = 0;
+     ENTRIES::iterator       I = m_entries.begin();
+     ENTRIES::iterator       E = m_entries.end();
+     for ( ; I != E; ++I) {
+         if (!(*I).m_object || (*I).m_pins || ((*I).m_last_used + lifetime >= time))
+             continue;
+ 
+         destroyer           ((*I).m_object);
+         (*I).m_object       = 0;
+         --m_decoded_count;
+         ++result;
+     }
+     m_stat_released         += result;
+     return                  (result);
+ }
+ 
+ template <typename _destroyer_type>
+ IC  void CALifeSpawnIndex::release_all          (const _destroyer_type &destroyer)
+ {
+     ENTRIES::iterator       I = m_entries.begin();
+     ENTRIES::iterator       E = m_entries.end();
+     for ( ; I != E; ++I) {
+         if (!(*I).m_object)
+             continue;
+ 
+         destroyer           ((*I).m_object);
+         (*I).m_object       = 0;
+         (*I).m_pins         = 0;
+     }
+     m_decoded_count         = 0;
+ }
+
+
+
+
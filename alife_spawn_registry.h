@@ -10,6 +10,7 @@
  #include "alife_spawn_registry_header.h"
  #include "xrServer_Objects_ALife_Monsters.h"
  #include "game_graph.h"
+ #include "alife_spawn_index.h"
  
  class CALifeSpawnRegistry : CRandom {
  public:
@@ -22,6 +23,23 @@
      ALife::ITEM_SET_MAP                     m_artefact_anomaly_map;
      LPSTR                                   m_spawn_name;
  
+ protected:
+     struct CSpawnDecoder {
+         IC  CSE_Abstract                    *operator()                 (IReader &chunk, u32 spawn_id) const;
+     };
+ 
+     struct CSpawnDestroyer {
+         IC  void                            operator()                  (CSE_Abstract *object) const;
+     };
+ 
+     // destroys the decoded entries it still holds on destruction
+     struct CSpawnIndex : public CALifeSpawnIndex {
+         IC                                  ~CSpawnIndex                ();
+     };
+ 
+ protected:
+     CSpawnIndex                             m_spawn_index;
+ 
  public:
                                              CALifeSpawnRegistry         (LPCSTR section);
      virtual                                 ~CALifeSpawnRegistry        ();
@@ -33,6 +51,13 @@
      IC      const ALife::D_OBJECT_P_VECTOR  &spawns                     () const;
      IC      void                            assign_artefact_position    (CSE_ALifeAnomalousZone *anomaly, CSE_ALifeDynamicObject *object);
      IC      const ALife::ITEM_SET_MAP       &artefact_anomaly_map       () const;
+     // lazy access to the mapped spawn entries
+     IC      void                            open_spawns                 (IReader *file, u32 chunk_id);
+     IC      CSE_Abstract                    *spawn                      (ALife::_SPAWN_ID spawn_id);
+     IC      void                            pin_spawn                   (ALife::_SPAWN_ID spawn_id);
+     IC      void                            unpin_spawn                 (ALife::_SPAWN_ID spawn_id);
+     IC      u32                             release_unused_spawns       (u32 lifetime);
+     IC      void                            release_spawns              ();
  };
  
  #include "alife_spawn_registry_inline.h"
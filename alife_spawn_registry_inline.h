@@ -35,6 +35,71 @@
  {
      return                  (m_artefact_anomaly_map);
  }
+ 
+ IC  CSE_Abstract *CALifeSpawnRegistry::CSpawnDecoder::operator()    (IReader &chunk, u32 spawn_id) const
+ {
+     NET_Packet              net_packet;
+     u16                     id;
+     string256               s_name;
+ 
+     net_packet.B.count      = chunk.r_u16();
+     chunk.r                 (net_packet.B.data,net_packet.B.count);
+     net_packet.r_begin      (id);
+     R_ASSERT2               (M_SPAWN == id,"Invalid spawn entry!");
+     net_packet.r_stringZ    (s_name);
+ 
+     CSE_Abstract            *object = F_entity_Create(s_name);
+     R_ASSERT3               (object,"Can't create entity.",s_name);
+     object->Spawn_Read      (net_packet);
+ 
+     net_packet.B.count      = chunk.r_u16();
+     chunk.r                 (net_packet.B.data,net_packet.B.count);
+     net_packet.r_begin      (id);
+     R_ASSERT2               (M_UPDATE == id,"Invalid spawn entry!");
+     object->UPDATE_Read     (net_packet);
+     return                  (object);
+ }
+ 
+ IC  void CALifeSpawnRegistry::CSpawnDestroyer::operator()           (CSE_Abstract *object) const
+ {
+     F_entity_Destroy        (object);
+ }
+ 
+ IC  CALifeSpawnRegistry::CSpawnIndex::~CSpawnIndex            ()
+ {
+     release_all             (CSpawnDestroyer());
+ }
+ 
+ IC  void CALifeSpawnRegistry::open_spawns                   (IReader *file, u32 chunk_id)
+ {
+     release_spawns          ();
+     m_spawn_index.open      (file,chunk_id);
+ }
+ 
+ IC  CSE_Abstract *CALifeSpawnRegistry::spawn                (ALife::_SPAWN_ID spawn_id)
+ {
+     return                  (m_spawn_index.object(spawn_id,CSpawnDecoder(),Device.dwTimeGlobal));
+ }
+ 
+ IC  void CALifeSpawnRegistry::pin_spawn                     (ALife::_SPAWN_ID spawn_id)
+ {
+     m_spawn_index.pin       (spawn_id);
+ }
+ 
+ IC  void CALifeSpawnRegistry::unpin_spawn                   (ALife::_SPAWN_ID spawn_id)
+ {
+     m_spawn_index.unpin     (spawn_id);
+ }
+ 
+ IC  u32 CALifeSpawnRegistry::release_unused_spawns          (u32 lifetime)
+ {
+     return                  (m_spawn_index.release_unused(Device.dwTimeGlobal,lifetime,CSpawnDestroyer()));
+ }
+ 
+ IC  void CALifeSpawnRegistry::release_spawns                ()
+ {
+     m_spawn_index.release_all   (CSpawnDestroyer());
+ }
 
 
 
@@ -19,6 +19,41 @@
      float           m_online_distance;
      float           m_offline_distance;
  
+ protected:
+     // objects crossing the switch distances are queued and switched a few per update,
+     // nearest first when going online, farthest first when going offline
+     struct SSwitchRequest {
+         ALife::_OBJECT_ID   m_id;
+         float               m_distance;
+     };
+ 
+     struct CNearestPredicate {
+         IC  bool    operator()  (const SSwitchRequest &request0, const SSwitchRequest &request1) const
+         {
+             return  (request0.m_distance > request1.m_distance);
+         }
+     };
+ 
+     struct CFarthestPredicate {
+         IC  bool    operator()  (const SSwitchRequest &request0, const SSwitchRequest &request1) const
+         {
+             return  (request0.m_distance < request1.m_distance);
+         }
+     };
+ 
+     typedef xr_vector<SSwitchRequest>           SWITCH_QUEUE;
+     typedef xr_map<ALife::_OBJECT_ID,bool>      QUEUED_OBJECTS;
+ 
+     SWITCH_QUEUE    m_online_queue;
+     SWITCH_QUEUE    m_offline_queue;
+     QUEUED_OBJECTS  m_queued_objects;       // object -> target state, the latest request wins
+     u32             m_switch_budget;        // objects switched per update in each direction
+ 
+ protected:
+     IC      void    prefetch_object         (const SWITCH_QUEUE &queue) const;
+     IC      void    push_switch_request     (ALife::_OBJECT_ID id, bool online, float distance);
+     IC      bool    pop_switch_request      (SWITCH_QUEUE &queue, bool online, CSE_ALifeDynamicObject *&object);
+ 
  protected:
              bool    synchronize_location    (CSE_ALifeDynamicObject *object);
              void    remove_online           (CSE_ALifeDynamicObject *object, bool update_registries = true);
@@ -26,6 +61,8 @@
              void    switch_online           (CSE_ALifeDynamicObject *object);
              void    switch_offline          (CSE_ALifeDynamicObject *object);
              void    furl_object             (CSE_ALifeDynamicObject *object);
+     IC      void    queue_switch            (CSE_ALifeDynamicObject *object, bool online, float distance);
+     IC      void    update_switch_queue     ();
  
  public:
      IC              CALifeSwitchManager     (xrServer *server, LPCSTR section);
@@ -36,6 +73,8 @@
      IC      float   switch_distance         () const;
      IC      void    set_switch_distance     (float switch_distance);
      IC      void    set_switch_factor       (float switch_factor);
+     IC      void    set_switch_budget       (u32 switch_budget);
+     IC      u32     queued_switch_count     () const;
  };
  
  #include "alife_switch_manager_inline.h"
@@ -7,12 +7,16 @@
  
  #pragma once
  
+ #include <xmmintrin.h>
+ #include "alife_object_registry.h"
+ 
  IC  CALifeSwitchManager::CALifeSwitchManager        (xrServer *server, LPCSTR section) :
      inherited       (server,section)
  {
      m_switch_distance   = pSettings->r_float(section,"switch_distance");
      m_switch_factor     = pSettings->r_float(section,"switch_factor");
      set_switch_distance (m_switch_distance);
+     m_switch_budget     = pSettings->line_exist(section,"switch_budget") ? pSettings->r_u32(section,"switch_budget") : 4;
  }
  
  IC  float CALifeSwitchManager::online_distance      () const
@@ -42,6 +46,105 @@
      m_switch_factor     = switch_factor;
      set_switch_distance (switch_distance());
  }
+ 
+ IC  void CALifeSwitchManager::set_switch_budget     (u32 switch_budget)
+ {
+     VERIFY              (switch_budget);
+     m_switch_budget     = switch_budget;
+ }
+ 
+ IC  u32 CALifeSwitchManager::queued_switch_count    () const
+ {
+     return              (u32(m_queued_objects.size()));
+ }
+ 
+ IC  void CALifeSwitchManager::queue_switch          (CSE_ALifeDynamicObject *object, bool online, float distance)
+ {
+     QUEUED_OBJECTS::iterator    I = m_queued_objects.find(object->ID);
+     if (I != m_queued_objects.end()) {
+         if ((*I).second == online)
+             return;
+ 
+         // the direction changed : either crossed back before it was switched or switched by another path,
+         // stale queue entries are skipped when popped
+         if (online == object->m_bOnline) {
+             m_queued_objects.erase(I);
+             return;
+         }
+ 
+         (*I).second     = online;
+         push_switch_request (object->ID,online,distance);
+         return;
+     }
+ 
+     if (online == object->m_bOnline)
+         return;
+ 
+     m_queued_objects.insert(std::make_pair(object->ID,online));
+     push_switch_request (object->ID,online,distance);
+ }
+ 
+ IC  void CALifeSwitchManager::push_switch_request   (ALife::_OBJECT_ID id, bool online, float distance)
+ {
+     SSwitchRequest      request;
+     request.m_id        = id;
+     request.m_distance  = distance;
+     if (online) {
+         m_online_queue.push_back(request);
+         std::push_heap  (m_online_queue.begin(),m_online_queue.end(),CNearestPredicate());
+     }
+     else {
+         m_offline_queue.push_back(request);
+         std::push_heap  (m_offline_queue.begin(),m_offline_queue.end(),CFarthestPredicate());
+     }
+ }
+ 
+ IC  bool CALifeSwitchManager::pop_switch_request    (SWITCH_QUEUE &queue, bool online, CSE_ALifeDynamicObject *&object)
+ {
+     while (!queue.empty()) {
+         SSwitchRequest  request = queue.front();
+         if (online)
+             std::pop_heap   (queue.begin(),queue.end(),CNearestPredicate());
+         else
+             std::pop_heap   (queue.begin(),queue.end(),CFarthestPredicate());
+         queue.pop_back  ();
+ 
+         QUEUED_OBJECTS::iterator    I = m_queued_objects.find(request.m_id);
+         if ((I == m_queued_objects.end()) || ((*I).second != online))
+             continue;
+ 
+         m_queued_objects.erase  (I);
+         object          = objects().object(request.m_id,true);
+         if (object && (object->m_bOnline != online))
+             return      (true);
+     }
+     return              (false);
+ }
+ 
+ IC  void CALifeSwitchManager::prefetch_object       (const SWITCH_QUEUE &queue) const
+ {
+     // the next object to switch is brought to cache while the current one is spawned
+     if (queue.empty())
+         return;
+ 
+     CSE_ALifeDynamicObject      *object = objects().object(queue.front().m_id,true);
+     if (object)
+         _mm_prefetch    ((char*)object,_MM_HINT_NTA);
+ }
+ 
+ IC  void CALifeSwitchManager::update_switch_queue   ()
+ {
+     CSE_ALifeDynamicObject      *object;
+     for (u32 i=0; (i < m_switch_budget) && pop_switch_request(m_online_queue,true,object); ++i) {
+         prefetch_object (m_online_queue);
+         switch_online   (object);
+     }
+ 
+     for (u32 i=0; (i < m_switch_budget) && pop_switch_request(m_offline_queue,false,object); ++i) {
+         prefetch_object (m_offline_queue);
+         switch_offline  (object);
+     }
+ }
 
 
 
@@ -0,0 +1,99 @@
+ //  Module      : alife_time_buckets.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife time bucketed storage with expiry
+ 
+ #pragma once
+ 
+ #include "alife_space.h"
+ #include "object_broker.h"
+ 
+ // Objects are kept in a ring of buckets, each covering a fixed span of game time.
+ // When time advances past the whole ring the objects of the oldest buckets are moved
+ // to the expired list, so the owner could unregister them before destroy_expired.
+ // Objects added with the time already out of the ring go there at once.
+ // Removal leaves a hole in the bucket, holes are squeezed out when the bucket is
+ // serialised. Every bucket keeps its serialised image and rebuilds it only when it
+ // changed, so a save costs the changed buckets plus a copy of the others.
+ // _data_type is an IPureSerializeObject, _id is its identifier, ids grow with time.
+ 
+ template <typename _data_type>
+ class CALifeTimeBuckets {
+ public:
+     typedef u32                     _id;
+     typedef xr_vector<_data_type*>  OBJECTS;
+ 
+ protected:
+     struct CItem {
+         _id                         m_id;
+         _data_type                  *m_object;
+ 
+         IC  bool                    operator<       (const _id &id) const
+         {
+             return                  (m_id < id);
+         }
+     };
+ 
+     struct CRemoveHolePredicate {
+         IC  bool                    operator()      (const CItem &item) const
+         {
+             return                  (!item.m_object);
+         }
+     };
+ 
+     typedef xr_vector<CItem>        ITEMS;
+ 
+     struct CBucket {
+         ITEMS                       m_items;        // sorted by id, 0 object is a hole
+         u32                         m_alive;
+         bool                        m_dirty;
+         xr_vector<u8>               m_image;        // items as they are saved
+     };
+ 
+     typedef xr_vector<CBucket>      BUCKETS;
+ 
+ protected:
+     BUCKETS                         m_buckets;
+     ALife::_TIME_ID                 m_span;         // game time covered by a bucket
+     u64                             m_newest;       // absolute number of the newest bucket
+     u32                             m_size;
+     OBJECTS                         m_expired;
+ 
+ protected:
+     IC      CBucket                 &bucket         (u64 absolute);
+     IC      const CBucket           &bucket         (u64 absolute) const;
+     IC      u64                     oldest          () const;
+     IC      void                    release         (CBucket &bucket, bool expire);
+     IC      void                    advance         (u64 absolute);
+     IC      CItem                   *find           (const _id &id, CBucket **bucket = 0) const;
+     IC      void                    serialize       (CBucket &bucket);
+ 
+ public:
+     IC                              CALifeTimeBuckets   (ALife::_TIME_ID span = 3600000, u32 bucket_count = 168);
+     virtual                         ~CALifeTimeBuckets  ();
+     IC      void                    setup           (ALife::_TIME_ID span, u32 bucket_count);
+     IC      bool                    add             (const _id &id, const ALife::_TIME_ID &time, _data_type *object);
+     IC      _data_type              *remove         (const _id &id);
+     IC      _data_type              *object         (const _id &id) const;
+     IC      void                    expire          (const ALife::_TIME_ID &time);
+     IC      const OBJECTS           &expired        () const;
+     IC      void                    destroy_expired ();
+     IC      void                    clear           ();
+     IC      u32                     size            () const;
+     IC      bool                    empty           () const;
+     IC      ALife::_TIME_ID         lifetime        () const;
+     IC      void                    save            (IWriter &stream);
+     template <typename _creator_type>
+     IC      void                    load            (IReader &stream, const _creator_type &creator);
+     // u32 count and the objects, as the maps were saved before ALIFE_VERSION 0x0002
+     template <typename _creator_type>
+     IC      void                    load_flat       (IReader &stream, const _creator_type &creator);
+     template <typename _functor_type>
+     IC      void                    iterate         (const _functor_type &functor) const;
+ };
+ 
+ #include "alife_time_buckets_inline.h"
+
+
+
+
@@ -0,0 +1,298 @@
+ //  Module      : alife_time_buckets_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife time bucketed storage with expiry inline functions
+ 
+ #pragma once
+ 
+ #define TEMPLATE_SPECIALIZATION template <typename _data_type>
+ #define CALifeTimeBucketsAbstract CALifeTimeBuckets<_data_type>
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  CALifeTimeBucketsAbstract::CALifeTimeBuckets    (ALife::_TIME_ID span, u32 bucket_count)
+ {
+     m_newest                = 0;
+     m_size                  = 0;
+     setup                   (span,bucket_count);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ CALifeTimeBucketsAbstract::~CALifeTimeBuckets       ()
+ {
+     clear                   ();
+     destroy_expired         ();
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::setup           (ALife::_TIME_ID span, u32 bucket_count)
+ {
+     VERIFY2                 (empty(),"Time buckets can be set up while empty only");
+     VERIFY                  (span && bucket_count);
+     m_span                  = span;
+     m_buckets.clear         ();
+     m_buckets.resize        (bucket_count);
+     for (u32 i=0; i<bucket_count; ++i) {
+         m_buckets[i].m_alive    = 0;
+         m_buckets[i].m_dirty    = true;
+     }
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CALifeTimeBucketsAbstract::CBucket &CALifeTimeBucketsAbstract::bucket  (u64 absolute)
+ {
+     return                  (m_buckets[u32(absolute % m_buckets.size())]);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  const typename CALifeTimeBucketsAbstract::CBucket &CALifeTimeBucketsAbstract::bucket(u64 absolute) const
+ {
+     return                  (m_buckets[u32(absolute % m_buckets.size())]);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u64 CALifeTimeBucketsAbstract::oldest           () const
+ {
+     return                  ((m_newest >= m_buckets.size()) ? m_newest - m_buckets.size() + 1 : 0);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::release         (CBucket &bucket, bool expire)
+ {
+     typename ITEMS::iterator    I = bucket.m_items.begin();
+     typename ITEMS::iterator    E = bucket.m_items.end();
+     for ( ; I != E; ++I) {
+         if (!(*I).m_object)
+             continue;
+         if (expire)
+             m_expired.push_back((*I).m_object);
+         else
+             xr_delete       ((*I).m_object);
+     }
+ 
+     m_size                  -= bucket.m_alive;
+     bucket.m_items.clear    ();
+     bucket.m_image.clear    ();
+     bucket.m_alive          = 0;
+     bucket.m_dirty          = true;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::advance         (u64 absolute)
+ {
+     if (absolute <= m_newest)
+         return;
+ 
+     // buckets falling out of the ring expire, no more than the ring itself
+     u64                     count = _min(absolute - m_newest,u64(m_buckets.size()));
+     for (u64 i=0; i<count; ++i)
+         release             (bucket(absolute - i),true);
+ 
+     m_newest                = absolute;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CALifeTimeBucketsAbstract::CItem *CALifeTimeBucketsAbstract::find(const _id &id, CBucket **bucket) const
+ {
+     // a handful of buckets, each holds a contiguous id range
+     BUCKETS                 &buckets = const_cast<BUCKETS&>(m_buckets);
+     typename BUCKETS::iterator  I = buckets.begin();
+     typename BUCKETS::iterator  E = buckets.end();
+     for ( ; I != E; ++I) {
+         if ((*I).m_items.empty() || (id < (*I).m_items.front().m_id) || ((*I).m_items.back().m_id < id))
+             continue;
+ 
+         typename ITEMS::iterator    i = std::lower_bound((*I).m_items.begin(),(*I).m_items.end(),id);
+         if ((i == (*I).m_items.end()) || ((*i).m_id != id) || !(*i).m_object)
+             continue;
+ 
+         if (bucket)
+             *bucket         = &*I;
+         return              (&*i);
+     }
+     return                  (0);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CALifeTimeBucketsAbstract::add             (const _id &id, const ALife::_TIME_ID &time, _data_type *object)
+ {
+     VERIFY                  (object);
+     u64                     absolute = time/m_span;
+     advance                 (absolute);
+     if (absolute < oldest()) {
+         m_expired.push_back (object);
+         return              (false);
+     }
+ 
+     CBucket                 &_bucket = bucket(absolute);
+     typename ITEMS::iterator    I = std::lower_bound(_bucket.m_items.begin(),_bucket.m_items.end(),id);
+     VERIFY2                 ((I == _bucket.m_items.end()) || ((*I).m_id != id),"Object with the specified ID is already presented in the time buckets!");
+ 
+     CItem                   item;
+     item.m_id               = id;
+     item.m_object           = object;
+     _bucket.m_items.insert  (I,item);
+     _bucket.m_dirty         = true;
+     ++_bucket.m_alive;
+     ++m_size;
+     return                  (true);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  _data_type *CALifeTimeBucketsAbstract::remove   (const _id &id)
+ {
+     CBucket                 *_bucket;
+     CItem                   *item = find(id,&_bucket);
+     if (!item)
+         return              (0);
+ 
+     _data_type              *object = item->m_object;
+     item->m_object          = 0;
+     --_bucket->m_alive;
+     _bucket->m_dirty        = true;
+     --m_size;
+     return                  (object);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  _data_type *CALifeTimeBucketsAbstract::object   (const _id &id) const
+ {
+     const CItem             *item = find(id);
+     return                  (item ? item->m_object : 0);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::expire          (const ALife::_TIME_ID &time)
+ {
+     advance                 (time/m_span);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  const typename CALifeTimeBucketsAbstract::OBJECTS &CALifeTimeBucketsAbstract::expired() const
+ {
+     return                  (m_expired);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::destroy_expired ()
+ {
+     delete_data             (m_expired);
+     m_expired.clear         ();
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::clear           ()
+ {
+     typename BUCKETS::iterator  I = m_buckets.begin();
+     typename BUCKETS::iterator  E = m_buckets.end();
+     for ( ; I != E; ++I)
+         release             (*I,false);
+     VERIFY                  (!m_size);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CALifeTimeBucketsAbstract::size             () const
+ {
+     return                  (m_size);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CALifeTimeBucketsAbstract::empty           () const
+ {
+     return                  (!m_size);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  ALife::_TIME_ID CALifeTimeBucketsAbstract::lifetime () const
+ {
+     return                  (m_span*m_buckets.size());
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::serialize       (CBucket &bucket)
+ {
+     if (!bucket.m_dirty)
+         return;
+ 
+     // squeeze the holes out
+     typename ITEMS::iterator    I = std::remove_if(bucket.m_items.begin(),bucket.m_items.end(),CRemoveHolePredicate());
+     bucket.m_items.erase    (I,bucket.m_items.end());
+     VERIFY                  (bucket.m_items.size() == bucket.m_alive);
+ 
+     CMemoryWriter           stream;
+     stream.w_u32            (bucket.m_alive);
+     typename ITEMS::iterator    i = bucket.m_items.begin();
+     typename ITEMS::iterator    e = bucket.m_items.end();
+     for ( ; i != e; ++i)
+         (*i).m_object->save (stream);
+ 
+     bucket.m_image.assign   (stream.pointer(),stream.pointer() + stream.size());
+     bucket.m_dirty          = false;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CALifeTimeBucketsAbstract::save            (IWriter &stream)
+ {
+     stream.w_u64            (m_newest);
+     stream.w_u32            (u32(m_buckets.size()));
+     for (u64 i=oldest(); i<=m_newest; ++i) {
+         CBucket             &_bucket = bucket(i);
+         serialize           (_bucket);
+         stream.w            (&*_bucket.m_image.begin(),u32(_bucket.m_image.size()));
+     }
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ template <typename _creator_type>
+ IC  void CALifeTimeBucketsAbstract::load            (IReader &stream, const _creator_type &creator)
+ {
+     clear                   ();
+     m_newest                = stream.r_u64();
+     u32                     bucket_count = stream.r_u32();
+     u64                     first = (m_newest >= bucket_count) ? m_newest - bucket_count + 1 : 0;
+     for (u64 i=first; i<=m_newest; ++i) {
+         // objects older than the configured ring go to the expired list
+         u32                 count = stream.r_u32();
+         for (u32 j=0; j<count; ++j) {
+             _id             id;
+             ALife::_TIME_ID time;
+             _data_type      *object = creator(stream,id,time);
+             add             (id,time,object);
+         }
+     }
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ template <typename _creator_type>
+ IC  void CALifeTimeBucketsAbstract::load_flat       (IReader &stream, const _creator_type &creator)
+ {
+     clear                   ();
+     m_newest                = 0;
+     u32                     count = stream.r_u32();
+     for (u32 i=0; i<count; ++i) {
+         _id                 id;
+         ALife::_TIME_ID     time;
+         _data_type          *object = creator(stream,id,time);
+         add                 (id,time,object);
+     }
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ template <typename _functor_type>
+ IC  void CALifeTimeBucketsAbstract::iterate         (const _functor_type &functor) const
+ {
+     for (u64 i=oldest(); i<=m_newest; ++i) {
+         const CBucket       &_bucket = bucket(i);
+         typename ITEMS::const_iterator  I = _bucket.m_items.begin();
+         typename ITEMS::const_iterator  E = _bucket.m_items.end();
+         for ( ; I != E; ++I)
+             if ((*I).m_object)
+                 functor     ((*I).m_object);
+     }
+ }
+ 
+ #undef TEMPLATE_SPECIALIZATION
+ #undef CALifeTimeBucketsAbstract
+
+
+
+
@@ -0,0 +1,42 @@
+ //  Module      : alife_trade_matcher.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife trade matcher, subset sums of trader items by dynamic programming
+ 
+ #pragma once
+ 
+ // 0/1 knapsack over item prices divided by their greatest common divisor.
+ // For every reachable sum the table keeps the first item (in inventory order) by which
+ // it was reached, so all the reachable sums are listed in O(sum) and the items making up
+ // any of them are restored in O(item count), always the same set for the same inventory.
+ // Sums above the bound are not tracked, the work is O(item count * bound / gcd).
+ 
+ class CALifeTradeMatcher {
+ public:
+     enum {
+         MAX_TABLE_SIZE              = u32(1 << 20),
+     };
+ 
+ protected:
+     typedef xr_vector<u16>          REACH_TABLE;
+ 
+ protected:
+     ALife::INT_VECTOR               m_prices;
+     REACH_TABLE                     m_reach;        // sum/gcd -> index of the item + 1, 0 - unreachable
+     int                             m_gcd;
+     int                             m_max_sum;
+ 
+ public:
+     IC                              CALifeTradeMatcher  ();
+     IC      void                    init                (const ALife::INT_VECTOR &prices, int max_sum);
+     IC      bool                    reachable           (int sum) const;
+     IC      void                    sums                (ALife::INT_VECTOR &sums) const;
+     IC      bool                    indexes             (int sum, ALife::INT_VECTOR &indexes) const;
+     IC      int                     max_sum             () const;
+ };
+ 
+ #include "alife_trade_matcher_inline.h"
+
+
+
+
@@ -0,0 +1,100 @@
+ //  Module      : alife_trade_matcher_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : ALife trade matcher, subset sums of trader items by dynamic programming inline functions
+ 
+ #pragma once
+ 
+ IC  CALifeTradeMatcher::CALifeTradeMatcher      ()
+ {
+     m_gcd                   = 1;
+     m_max_sum               = 0;
+ }
+ 
+ IC  void CALifeTradeMatcher::init               (const ALife::INT_VECTOR &prices, int max_sum)
+ {
+     VERIFY                  (prices.size() < u32(u16(-1)));
+     m_prices                = prices;
+ 
+     int                     total = 0;
+     m_gcd                   = 0;
+     ALife::INT_VECTOR::const_iterator   I = m_prices.begin();
+     ALife::INT_VECTOR::const_iterator   E = m_prices.end();
+     for ( ; I != E; ++I) {
+         VERIFY              (*I >= 0);
+         total               += *I;
+         for (int a = m_gcd, b = *I; ; ) {
+             if (!b) {
+                 m_gcd       = a;
+                 break;
+             }
+             int             c = a % b;
+             a               = b;
+             b               = c;
+         }
+     }
+     if (!m_gcd)
+         m_gcd               = 1;
+ 
+     m_max_sum               = _min(max_sum,total);
+     u32                     size = u32(m_max_sum/m_gcd) + 1;
+     if (size > MAX_TABLE_SIZE) {
+         size                = MAX_TABLE_SIZE;
+         m_max_sum           = int(size - 1)*m_gcd;
+     }
+ 
+     m_reach.assign          (size,0);
+     m_reach[0]              = u16(-1);  // the empty set
+ 
+     u32                     upper = 0;
+     for (u32 i=0, n=u32(m_prices.size()); i<n; ++i) {
+         u32                 price = u32(m_prices[i]/m_gcd);
+         if (!price || (price >= size))
+             continue;
+ 
+         // downwards, so every item is taken at most once
+         upper               = _min(upper + price,size - 1);
+         for (u32 j=upper; j >= price; --j)
+             if (!m_reach[j] && m_reach[j - price])
+                 m_reach[j]  = u16(i + 1);
+     }
+ }
+ 
+ IC  bool CALifeTradeMatcher::reachable          (int sum) const
+ {
+     if ((sum < 0) || (sum > m_max_sum) || (sum % m_gcd))
+         return              (false);
+     return                  (!!m_reach[sum/m_gcd]);
+ }
+ 
+ IC  void CALifeTradeMatcher::sums               (ALife::INT_VECTOR &sums) const
+ {
+     sums.clear              ();
+     for (u32 i=0, n=u32(m_reach.size()); i<n; ++i)
+         if (m_reach[i])
+             sums.push_back  (int(i)*m_gcd);
+ }
+ 
+ IC  bool CALifeTradeMatcher::indexes            (int sum, ALife::INT_VECTOR &indexes) const
+ {
+     indexes.clear           ();
+     if (!reachable(sum))
+         return              (false);
+ 
+     for (u32 j=u32(sum/m_gcd); j; ) {
+         u32                 i = u32(m_reach[j]) - 1;
+         indexes.push_back   (int(i));
+         j                   -= u32(m_prices[i]/m_gcd);
+     }
+     std::reverse            (indexes.begin(),indexes.end());
+     return                  (true);
+ }
+ 
+ IC  int CALifeTradeMatcher::max_sum             () const
+ {
+     return                  (m_max_sum);
+ }
+
+
+
+
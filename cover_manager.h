@@ -8,6 +8,7 @@
  #pragma once
  
  #include "quadtree.h"
+ #include "cover_query_cache.h"
  
  class CCoverPoint;
  
@@ -19,6 +20,7 @@
      CPointQuadTree                  *m_covers;
      xr_vector<bool>                 m_temp;
      mutable xr_vector<CCoverPoint*> m_nearest;
+     mutable CCoverQueryCache        m_query_cache;
  
  
  protected:
@@ -38,6 +40,9 @@
      IC      CCoverPoint             *best_cover         (const Fvector &position, float radius, _evaluator_type &evaluator, const _restrictor_type &restrictor) const;
      template <typename _evaluator_type>
      IC      CCoverPoint             *best_cover         (const Fvector &position, float radius, _evaluator_type &evaluator) const;
+     template <typename _scorer_type, typename _restrictor_type>
+     IC      u32                     best_covers         (const Fvector &position, float radius, const Fvector &enemy_position, const _scorer_type &scorer, const _restrictor_type &restrictor, u32 count, xr_vector<CCoverPoint*> &result, float min_score = -flt_max) const;
+     IC      CCoverQueryCache        &query_cache        () const;
      IC      bool                    operator()			(const CCoverPoint *) const;
  };
  
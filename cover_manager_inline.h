@@ -45,6 +45,36 @@
      return                  (best_cover<_evaluator_type,CCoverManager>(position,radius,evaluator,*this));
  }
  
+ // scorer: 'u32 id() const' and 'float score(const CCoverPoint*, const Fvector &enemy_position) const', the score must not depend on the NPC;
+ // everything NPC specific (accessibility, restrictions, distance to the NPC) goes to the restrictor
+ template <typename _scorer_type, typename _restrictor_type>
+ IC  u32 CCoverManager::best_covers          (const Fvector &position, float radius, const Fvector &enemy_position, const _scorer_type &scorer, const _restrictor_type &restrictor, u32 count, xr_vector<CCoverPoint*> &result, float min_score) const
+ {
+     result.clear            ();
+     m_query_cache.update    (Device.dwTimeGlobal);
+ 
+     const CCoverQueryCache::SCORED_COVERS   &covers = m_query_cache.covers(this->covers(),position,radius,enemy_position,scorer,m_nearest,Device.dwTimeGlobal);
+     CCoverQueryCache::SCORED_COVERS::const_iterator I = covers.begin();
+     CCoverQueryCache::SCORED_COVERS::const_iterator E = covers.end();
+     for ( ; (I != E) && (result.size() < count); ++I) {
+         if ((*I).first < min_score)
+             break;
+ 
+         if ((*I).second->position().distance_to_sqr(position) > _sqr(radius))
+             continue;
+ 
+         if (restrictor((*I).second))
+             result.push_back((*I).second);
+     }
+ 
+     return                  (u32(result.size()));
+ }
+ 
+ IC  CCoverQueryCache &CCoverManager::query_cache    () const
+ {
+     return                  (m_query_cache);
+ }
+ 
  IC  bool CCoverManager::operator()			(const CCoverPoint *) const
  {
      return                  (true);
@@ -0,0 +1,84 @@
+ //  Module      : cover_query_cache.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Shared cover scores cache
+ 
+ #pragma once
+ 
+ class CCoverPoint;
+ 
+ // Cover scores which depend only on the enemy position are computed once per
+ // (scorer, enemy cell, area cell, radius in area cells) and shared among all the NPCs querying the same area
+ // against the same enemy. Entries are sorted by score, so k-best queries stop as soon as
+ // k covers pass the per-NPC restrictor or the score drops below the bound.
+ // Entries hold cover pointers, so the cache is dropped whenever the cover tree changes or is replaced
+ // (the tree stamp differs). Empty results are cached as well.
+ 
+ class CCoverQueryCache {
+ public:
+     typedef std::pair<float,CCoverPoint*>   CScoredCover;
+     typedef xr_vector<CScoredCover>         SCORED_COVERS;
+ 
+     struct CEntry {
+         SCORED_COVERS               m_covers;
+         u32                         m_time;
+     };
+ 
+     struct CScorePredicate {
+         IC  bool                    operator()          (const CScoredCover &cover0, const CScoredCover &cover1) const
+         {
+             return                  (cover0.first > cover1.first);
+         }
+     };
+ 
+     struct CKey {
+         u32                         m_scorer_id;
+         u32                         m_enemy_cell;
+         u32                         m_area_cell;
+         u32                         m_radius;       // in area cells, rounded up
+ 
+         IC  bool                    operator<           (const CKey &key) const
+         {
+             if (m_scorer_id != key.m_scorer_id)
+                 return              (m_scorer_id < key.m_scorer_id);
+             if (m_enemy_cell != key.m_enemy_cell)
+                 return              (m_enemy_cell < key.m_enemy_cell);
+             if (m_area_cell != key.m_area_cell)
+                 return              (m_area_cell < key.m_area_cell);
+             return                  (m_radius < key.m_radius);
+         }
+     };
+ 
+     typedef xr_map<CKey,CEntry>     ENTRIES;
+ 
+ private:
+     ENTRIES                         m_entries;
+     float                           m_enemy_cell_size;
+     float                           m_area_cell_size;
+     u32                             m_lifetime;
+     u32                             m_last_collect;
+     u32                             m_tree_stamp;
+ 
+ public:
+     u32                             m_stat_hits;
+     u32                             m_stat_misses;
+ 
+ protected:
+     IC      u32                     cell                (const Fvector &position, float cell_size) const;
+     IC      CKey                    key                 (u32 scorer_id, const Fvector &enemy_position, const Fvector &position, float radius) const;
+ 
+ public:
+     IC                              CCoverQueryCache    (float enemy_cell_size = 2.f, float area_cell_size = 8.f, u32 lifetime = 1000);
+     IC      float                   area_cell_size      () const;
+     template <typename _scorer_type>
+     IC      const SCORED_COVERS     &covers             (const CQuadTree<CCoverPoint> &tree, const Fvector &position, float radius, const Fvector &enemy_position, const _scorer_type &scorer, xr_vector<CCoverPoint*> &temp, u32 time);
+     IC      void                    collect_garbage     (u32 time);
+     IC      void                    update              (u32 time);
+     IC      void                    clear               ();
+ };
+ 
+ #include "cover_query_cache_inline.h"
+
+
+
+
@@ -0,0 +1,107 @@
+ //  Module      : cover_query_cache_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Shared cover scores cache inline functions
+ 
+ #pragma once
+ 
+ IC  CCoverQueryCache::CCoverQueryCache          (float enemy_cell_size, float area_cell_size, u32 lifetime)
+ {
+     m_enemy_cell_size       = enemy_cell_size;
+     m_area_cell_size        = area_cell_size;
+     m_lifetime              = lifetime;
+     m_last_collect          = 0;
+     m_tree_stamp            = 0;
+     m_stat_hits             = 0;
+     m_stat_misses           = 0;
+ }
+ 
+ IC  u32 CCoverQueryCache::cell                  (const Fvector &position, float cell_size) const
+ {
+     // 16 bits per axis are enough for any level with the cell sizes used
+     u32                     x = u32(iFloor(position.x/cell_size)) & 0xffff;
+     u32                     z = u32(iFloor(position.z/cell_size)) & 0xffff;
+     return                  ((x << 16) | z);
+ }
+ 
+ IC  CCoverQueryCache::CKey CCoverQueryCache::key  (u32 scorer_id, const Fvector &enemy_position, const Fvector &position, float radius) const
+ {
+     CKey                    result;
+     result.m_scorer_id      = scorer_id;
+     result.m_enemy_cell     = cell(enemy_position,m_enemy_cell_size);
+     result.m_area_cell      = cell(position,m_area_cell_size);
+     result.m_radius         = u32(iCeil(radius/m_area_cell_size));
+     return                  (result);
+ }
+ 
+ IC  float CCoverQueryCache::area_cell_size      () const
+ {
+     return                  (m_area_cell_size);
+ }
+ 
+ template <typename _scorer_type>
+ IC  const CCoverQueryCache::SCORED_COVERS &CCoverQueryCache::covers (const CQuadTree<CCoverPoint> &tree, const Fvector &position, float radius, const Fvector &enemy_position, const _scorer_type &scorer, xr_vector<CCoverPoint*> &temp, u32 time)
+ {
+     if (tree.stamp() != m_tree_stamp) {
+         clear               ();
+         m_tree_stamp        = tree.stamp();
+     }
+ 
+     CKey                    entry_key = key(scorer.id(),enemy_position,position,radius);
+     ENTRIES::iterator       I = m_entries.find(entry_key);
+     if ((I != m_entries.end()) && (time - (*I).second.m_time <= m_lifetime)) {
+         ++m_stat_hits;
+         return              ((*I).second.m_covers);
+     }
+ 
+     CEntry                  &entry = (I != m_entries.end()) ? (*I).second : m_entries[entry_key];
+ 
+     ++m_stat_misses;
+     entry.m_time            = time;
+     entry.m_covers.clear    ();
+ 
+     // covers of the whole area cell neighbourhood for the rounded up radius, so every NPC in the cell
+     // asking for a radius of the same number of cells is served by the entry
+     Fvector                 center;
+     center.set              ((iFloor(position.x/m_area_cell_size) + .5f)*m_area_cell_size,position.y,(iFloor(position.z/m_area_cell_size) + .5f)*m_area_cell_size);
+     tree.nearest            (center,float(entry_key.m_radius + 1)*m_area_cell_size,temp);
+ 
+     xr_vector<CCoverPoint*>::const_iterator J = temp.begin();
+     xr_vector<CCoverPoint*>::const_iterator E = temp.end();
+     for ( ; J != E; ++J)
+         entry.m_covers.push_back(std::make_pair(scorer.score(*J,enemy_position),*J));
+ 
+     std::sort               (entry.m_covers.begin(),entry.m_covers.end(),CScorePredicate());
+     return                  (entry.m_covers);
+ }
+ 
+ IC  void CCoverQueryCache::collect_garbage      (u32 time)
+ {
+     ENTRIES::iterator       I = m_entries.begin();
+     ENTRIES::iterator       E = m_entries.end();
+     while (I != E) {
+         if (time - (*I).second.m_time > m_lifetime)
+             m_entries.erase (I++);
+         else
+             ++I;
+     }
+ }
+ 
+ IC  void CCoverQueryCache::update               (u32 time)
+ {
+     if (time - m_last_collect < m_lifetime)
+         return;
+ 
+     m_last_collect          = time;
+     collect_garbage         (time);
+ }
+ 
+ IC  void CCoverQueryCache::clear                ()
+ {
+     m_entries.clear         ();
+     m_tree_stamp            = 0;
+ }
+
+
+
+
@@ -0,0 +1,81 @@
+ //  Module      : data_storage_radix_heap.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Radix heap data storage
+ 
+ #pragma once
+ 
+ #include "data_storage_double_linked_list.h"
+ 
+ // Monotone priority queue for searches where extracted 'f' never decreases (A* with
+ // a consistent heuristics, Dijkstra). 'f' is quantized relative to the start vertex value,
+ // a vertex lives in bucket 1 + msb(key ^ last extracted key), so every vertex is moved
+ // at most 32 times between buckets during a search. Keys below the last extracted one
+ // (inconsistent heuristics) are clamped to it.
+ 
+ template <u32 quantum_inverse = 1024>
+ struct CDataStorageRadixHeap {
+ 
+     enum {
+         bucket_count = 33,
+     };
+ 
+     template <template <typename _T> class T1>
+     struct RadixHeap {
+         template<typename T2>
+         struct _vertex : public T1<T2> {
+             u32             m_key;
+             u32             m_bucket_id;
+         };
+     };
+ 
+     template <
+         typename _data_storage,
+         template <typename _T> class _vertex = CEmptyClassTemplate
+     >
+     class CDataStorage : public CDataStorageDoubleLinkedList<false>::CDataStorage<_data_storage,RadixHeap<_vertex>::_vertex> {
+     public:
+         typedef typename CDataStorageDoubleLinkedList<false>::CDataStorage<
+             _data_storage,
+             RadixHeap<_vertex>::_vertex
+         >                                           inherited;
+         typedef typename inherited::inherited_base  inherited_base;
+         typedef typename inherited::CGraphVertex    CGraphVertex;
+         typedef typename CGraphVertex::_dist_type   _dist_type;
+         typedef typename CGraphVertex::_index_type  _index_type;
+ 
+     protected:
+         CGraphVertex            *m_buckets[bucket_count];
+         u32                     m_last_key;
+         _dist_type              m_base_value;
+         bool                    m_base_set;
+         u32                     m_opened_count;
+ 
+     public:
+         u32                     m_stat_redistributed;
+ 
+     protected:
+         IC      u32             compute_key         (const CGraphVertex &vertex) const;
+         IC      u32             compute_bucket_id   (u32 key) const;
+         IC      void            add_to_bucket       (CGraphVertex &vertex);
+         IC      void            remove_from_bucket  (CGraphVertex &vertex);
+         IC      void            redistribute        ();
+ 
+     public:
+         IC                      CDataStorage        (const u32 vertex_count);
+         virtual                 ~CDataStorage       ();
+         IC      void            init                ();
+         IC      bool            is_opened_empty     () const;
+         IC      void            add_opened          (CGraphVertex &vertex);
+         IC      void            decrease_opened     (CGraphVertex &vertex, const _dist_type value);
+         IC      void            remove_best_opened  ();
+         IC      void            add_best_closed     ();
+         IC      CGraphVertex    &get_best           ();
+     };
+ };
+ 
+ #include "data_storage_radix_heap_inline.h"
+
+
+
+
@@ -0,0 +1,179 @@
+ //  Module      : data_storage_radix_heap_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Radix heap data storage inline functions
+ 
+ #pragma once
+ 
+ #define TEMPLATE_SPECIALIZATION \
+     template <u32 quantum_inverse>\
+     template <\
+         typename _data_storage,\
+         template <typename _T> class _vertex\
+     >
+ 
+ #define CRadixHeap CDataStorageRadixHeap<quantum_inverse>::CDataStorage<_data_storage,_vertex>
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  CRadixHeap::CDataStorage            (const u32 vertex_count) :
+         inherited(vertex_count)
+ {
+     ZeroMemory              (m_buckets,bucket_count*sizeof(CGraphVertex*));
+     m_stat_redistributed    = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ CRadixHeap::~CDataStorage               ()
+ {
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::init               ()
+ {
+     inherited::init         ();
+     ZeroMemory              (m_buckets,bucket_count*sizeof(CGraphVertex*));
+     m_last_key              = 0;
+     m_base_set              = false;
+     m_opened_count          = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32  CRadixHeap::compute_key        (const CGraphVertex &vertex) const
+ {
+     // keys are relative to the first opened vertex, so the quantization range follows the search
+     _dist_type              value = (vertex.f() - m_base_value)*_dist_type(quantum_inverse);
+     if (value >= _dist_type(u32(-1)))
+         return              (u32(-1));
+     u32                     key = (value > _dist_type(0)) ? u32(value) : 0;
+     return                  (_max(key,m_last_key));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32  CRadixHeap::compute_bucket_id  (u32 key) const
+ {
+     u32                     difference = key ^ m_last_key;
+     if (!difference)
+         return              (0);
+ 
+     u32                     result = 1;
+     for ( ; difference >>= 1; ++result);
+     return                  (result);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::add_to_bucket      (CGraphVertex &vertex)
+ {
+     vertex.m_bucket_id      = compute_bucket_id(vertex.m_key);
+     CGraphVertex            *&head = m_buckets[vertex.m_bucket_id];
+     vertex.prev()           = 0;
+     vertex.next()           = head;
+     if (head)
+         head->prev()        = &vertex;
+     head                    = &vertex;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::remove_from_bucket (CGraphVertex &vertex)
+ {
+     if (vertex.prev())
+         vertex.prev()->next()   = vertex.next();
+     else {
+         VERIFY              (m_buckets[vertex.m_bucket_id] == &vertex);
+         m_buckets[vertex.m_bucket_id] = vertex.next();
+     }
+     if (vertex.next())
+         vertex.next()->prev()   = vertex.prev();
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::redistribute       ()
+ {
+     // bucket 0 is empty : the minimum of the first non-empty bucket becomes the last key
+     // and the bucket contents spread to the lower buckets
+     if (m_buckets[0])
+         return;
+ 
+     u32                     bucket_id = 1;
+     for ( ; !m_buckets[bucket_id]; ++bucket_id)
+         VERIFY              (bucket_id + 1 < bucket_count);
+ 
+     CGraphVertex            *i = m_buckets[bucket_id];
+     u32                     min_key = i->m_key;
+     for (i = i->next(); i; i = i->next())
+         if (i->m_key < min_key)
+             min_key         = i->m_key;
+ 
+     m_last_key              = min_key;
+     i                       = m_buckets[bucket_id];
+     m_buckets[bucket_id]    = 0;
+     while (i) {
+         CGraphVertex        *next = i->next();
+         add_to_bucket       (*i);
+         VERIFY              (i->m_bucket_id < bucket_id);
+         ++m_stat_redistributed;
+         i                   = next;
+     }
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CRadixHeap::is_opened_empty    () const
+ {
+     return                  (!m_opened_count);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::add_opened         (CGraphVertex &vertex)
+ {
+     inherited_base::add_opened  (vertex);
+     if (!m_base_set) {
+         m_base_value        = vertex.f();
+         m_base_set          = true;
+     }
+     vertex.m_key            = compute_key(vertex);
+     add_to_bucket           (vertex);
+     ++m_opened_count;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::decrease_opened    (CGraphVertex &vertex, const _dist_type value)
+ {
+     VERIFY                  (!is_opened_empty());
+     u32                     key = compute_key(vertex);
+     if (key == vertex.m_key)
+         return;
+ 
+     remove_from_bucket      (vertex);
+     vertex.m_key            = key;
+     add_to_bucket           (vertex);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::remove_best_opened ()
+ {
+     VERIFY                  (!is_opened_empty());
+     redistribute            ();
+     remove_from_bucket      (*m_buckets[0]);
+     --m_opened_count;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CRadixHeap::add_best_closed    ()
+ {
+     VERIFY                  (!is_opened_empty());
+     inherited_base::add_closed  (get_best());
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CRadixHeap::CGraphVertex &CRadixHeap::get_best  ()
+ {
+     VERIFY                  (!is_opened_empty());
+     redistribute            ();
+     return                  (*m_buckets[0]);
+ }
+ 
+ #undef TEMPLATE_SPECIALIZATION
+ #undef CRadixHeap
+
+
+
+
@@ -0,0 +1,104 @@
+ //  Module      : dense_id_map.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Map over small integer ids with array lookup
+ 
+ #pragma once
+ 
+ // Values are kept in a vector sorted by id (iteration order and (*I).first/(*I).second as with xr_map),
+ // ids below _dense_limit are found through the id -> position table, larger ones by binary search.
+ // Insertion and removal are linear, they are expected to happen at setup only.
+ 
+ template <
+     typename _key_type,
+     typename _data_type,
+     u32      _dense_limit = 1024
+ >
+ class CDenseIdMap {
+ public:
+     typedef std::pair<_key_type,_data_type>         value_type;
+     typedef xr_vector<value_type>                   VALUES;
+     typedef typename VALUES::iterator               iterator;
+     typedef typename VALUES::const_iterator         const_iterator;
+ 
+ protected:
+     struct CKeyPredicate {
+         IC  bool                    operator()      (const value_type &value, const _key_type &key) const
+         {
+             return                  (value.first < key);
+         }
+     };
+ 
+ protected:
+     VALUES                          m_values;
+     xr_vector<u16>                  m_index;        // position + 1, 0 if absent
+ 
+ protected:
+     IC      void                    rebuild_index   ()
+     {
+         m_index.assign              (m_index.size(),0);
+         for (u32 i=0, n=u32(m_values.size()); i<n; ++i)
+             if (u32(m_values[i].first) < _dense_limit)
+                 m_index[u32(m_values[i].first)] = u16(i + 1);
+     }
+ 
+ public:
+     IC      iterator                begin           ()          { return (m_values.begin());    }
+     IC      iterator                end             ()          { return (m_values.end());      }
+     IC      const_iterator          begin           () const    { return (m_values.begin());    }
+     IC      const_iterator          end             () const    { return (m_values.end());      }
+     IC      bool                    empty           () const    { return (m_values.empty());    }
+     IC      u32                     size            () const    { return (u32(m_values.size()));}
+ 
+     IC      u32                     position        (const _key_type &key) const
+     {
+         if (u32(key) < _dense_limit)
+             return                  ((u32(key) < m_index.size()) ? u32(m_index[u32(key)]) - 1 : u32(-1));
+ 
+         const_iterator              I = std::lower_bound(m_values.begin(),m_values.end(),key,CKeyPredicate());
+         return                      (((I == m_values.end()) || ((*I).first != key)) ? u32(-1) : u32(I - m_values.begin()));
+     }
+ 
+     IC      iterator                find            (const _key_type &key)
+     {
+         u32                         i = position(key);
+         return                      ((i == u32(-1)) ? m_values.end() : m_values.begin() + i);
+     }
+ 
+     IC      const_iterator          find            (const _key_type &key) const
+     {
+         u32                         i = position(key);
+         return                      ((i == u32(-1)) ? m_values.end() : m_values.begin() + i);
+     }
+ 
+     IC      std::pair<iterator,bool>insert          (const value_type &value)
+     {
+         iterator                    I = std::lower_bound(m_values.begin(),m_values.end(),value.first,CKeyPredicate());
+         if ((I != m_values.end()) && ((*I).first == value.first))
+             return                  (std::make_pair(I,false));
+ 
+         VERIFY                      (m_values.size() < u16(-1));
+         u32                         index = u32(I - m_values.begin());
+         m_values.insert             (I,value);
+         if ((u32(value.first) < _dense_limit) && (u32(value.first) >= m_index.size()))
+             m_index.resize          (u32(value.first) + 1,0);
+         rebuild_index               ();
+         return                      (std::make_pair(m_values.begin() + index,true));
+     }
+ 
+     IC      void                    erase           (iterator I)
+     {
+         m_values.erase              (I);
+         rebuild_index               ();
+     }
+ 
+     IC      void                    clear           ()
+     {
+         m_values.clear              ();
+         m_index.clear               ();
+     }
+ };
+
+
+
+
@@ -0,0 +1,73 @@
+ //  Module      : detail_path_cache.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Detail path trajectory segments cache
+ 
+ #pragma once
+ 
+ // Smooth trajectory segments between two key points depend only on the key points,
+ // the directions in them and the velocities used. Segments are stored by
+ // (start vertex, dest vertex, direction classes, velocity indices) and reused when
+ // the key points positions match within a tolerance, so re-aiming along the same route
+ // does not recompute the same curves and straight line checks.
+ 
+ template <typename _point_type>
+ class CDetailPathCache {
+ public:
+     typedef xr_vector<_point_type>  PATH;
+ 
+     enum {
+         DIRECTION_CLASS_COUNT       = 32,
+     };
+ 
+     struct CKey {
+         u32                         m_start_vertex_id;
+         u32                         m_dest_vertex_id;
+         u32                         m_directions;   // start class | (dest class << 16)
+         u32                         m_velocities;   // velocity1 | (velocity2 << 8) | (velocity3 << 16)
+ 
+         IC  bool                    operator<       (const CKey &key) const
+         {
+             if (m_start_vertex_id != key.m_start_vertex_id)
+                 return              (m_start_vertex_id < key.m_start_vertex_id);
+             if (m_dest_vertex_id != key.m_dest_vertex_id)
+                 return              (m_dest_vertex_id < key.m_dest_vertex_id);
+             if (m_directions != key.m_directions)
+                 return              (m_directions < key.m_directions);
+             return                  (m_velocities < key.m_velocities);
+         }
+     };
+ 
+     struct CEntry {
+         Fvector2                    m_start_position;
+         Fvector2                    m_dest_position;
+         u32                         m_time;
+         PATH                        m_path;
+     };
+ 
+     typedef xr_map<CKey,CEntry>     ENTRIES;
+ 
+ protected:
+     ENTRIES                         m_entries;
+     u32                             m_max_entry_count;
+     float                           m_tolerance;
+ 
+ public:
+     u32                             m_stat_hits;
+     u32                             m_stat_misses;
+ 
+ public:
+     IC                              CDetailPathCache    (u32 max_entry_count = 64, float tolerance = .05f);
+     IC  static  u32                 direction_class     (const Fvector2 &direction);
+     IC  static  CKey                key                 (u32 start_vertex_id, const Fvector2 &start_direction, u32 dest_vertex_id, const Fvector2 &dest_direction, u32 velocity1, u32 velocity2, u32 velocity3);
+     IC          const PATH          *find               (const CKey &key, const Fvector2 &start_position, const Fvector2 &dest_position, u32 time);
+     IC          void                add                 (const CKey &key, const Fvector2 &start_position, const Fvector2 &dest_position, const PATH &path, u32 time);
+     IC          void                collect_garbage     (u32 time, u32 lifetime);
+     IC          void                clear               ();
+ };
+ 
+ #include "detail_path_cache_inline.h"
+
+
+
+
@@ -0,0 +1,100 @@
+ //  Module      : detail_path_cache_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Detail path trajectory segments cache inline functions
+ 
+ #pragma once
+ 
+ #define TEMPLATE_SPECIALIZATION template <typename _point_type>
+ #define CDetailPathCacheAbstract CDetailPathCache<_point_type>
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  CDetailPathCacheAbstract::CDetailPathCache      (u32 max_entry_count, float tolerance)
+ {
+     m_max_entry_count       = max_entry_count;
+     m_tolerance             = tolerance;
+     m_stat_hits             = 0;
+     m_stat_misses           = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CDetailPathCacheAbstract::direction_class   (const Fvector2 &direction)
+ {
+     if (fis_zero(direction.square_magnitude()))
+         return              (DIRECTION_CLASS_COUNT);
+ 
+     float                   angle = angle_normalize(atan2f(direction.x,direction.y));
+     return                  (iFloor(angle*float(DIRECTION_CLASS_COUNT)/PI_MUL_2 + .5f) % DIRECTION_CLASS_COUNT);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CDetailPathCacheAbstract::CKey CDetailPathCacheAbstract::key(u32 start_vertex_id, const Fvector2 &start_direction, u32 dest_vertex_id, const Fvector2 &dest_direction, u32 velocity1, u32 velocity2, u32 velocity3)
+ {
+     VERIFY                  ((velocity1 < 256) && (velocity2 < 256) && (velocity3 < 256));
+     CKey                    result;
+     result.m_start_vertex_id= start_vertex_id;
+     result.m_dest_vertex_id = dest_vertex_id;
+     result.m_directions     = direction_class(start_direction) | (direction_class(dest_direction) << 16);
+     result.m_velocities     = velocity1 | (velocity2 << 8) | (velocity3 << 16);
+     return                  (result);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  const typename CDetailPathCacheAbstract::PATH *CDetailPathCacheAbstract::find(const CKey &key, const Fvector2 &start_position, const Fvector2 &dest_position, u32 time)
+ {
+     typename ENTRIES::iterator  I = m_entries.find(key);
+     if ((I == m_entries.end()) || !(*I).second.m_start_position.similar(start_position,m_tolerance) || !(*I).second.m_dest_position.similar(dest_position,m_tolerance)) {
+         ++m_stat_misses;
+         return              (0);
+     }
+ 
+     ++m_stat_hits;
+     (*I).second.m_time      = time;
+     return                  (&(*I).second.m_path);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CDetailPathCacheAbstract::add              (const CKey &key, const Fvector2 &start_position, const Fvector2 &dest_position, const PATH &path, u32 time)
+ {
+     if ((m_entries.size() >= m_max_entry_count) && (m_entries.find(key) == m_entries.end())) {
+         // evict the least recently used segment
+         typename ENTRIES::iterator  I = m_entries.begin(), J = I;
+         typename ENTRIES::iterator  E = m_entries.end();
+         for ( ; I != E; ++I)
+             if ((*I).second.m_time < (*J).second.m_time)
+                 J           = I;
+         m_entries.erase     (J);
+     }
+ 
+     CEntry                  &entry = m_entries[key];
+     entry.m_start_position  = start_position;
+     entry.m_dest_position   = dest_position;
+     entry.m_time            = time;
+     entry.m_path            = path;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CDetailPathCacheAbstract::collect_garbage  (u32 time, u32 lifetime)
+ {
+     typename ENTRIES::iterator  I = m_entries.begin();
+     typename ENTRIES::iterator  E = m_entries.end();
+     while (I != E) {
+         if ((*I).second.m_time + lifetime < time)
+             m_entries.erase (I++);
+         else
+             ++I;
+     }
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CDetailPathCacheAbstract::clear            ()
+ {
+     m_entries.clear         ();
+ }
+ 
+ #undef TEMPLATE_SPECIALIZATION
+ #undef CDetailPathCacheAbstract
+
+
+
+
@@ -47,6 +47,8 @@
  
  using namespace DetailPathManager;
  
+ #include "detail_path_cache.h"
+ 
  class CDetailPathManager :
      virtual public CAI_ObjectLocation
  {
@@ -146,6 +148,20 @@
      u32                                         m_last_patrol_point;
      u32                                         m_time_path_built;
  
+ private:
+     typedef CDetailPathCache<STravelPathPoint>  TRAJECTORY_CACHE;
+ 
+     TRAJECTORY_CACHE                            m_trajectory_cache;
+     xr_vector<STravelPathPoint>                 m_cache_path;
+     // restrictions the cached trajectories were built under
+     shared_str                                  m_cache_out_restrictions;
+     shared_str                                  m_cache_in_restrictions;
+     // what the current path was built for, to reuse its unchanged suffix
+     xr_vector<u32>                              m_built_level_path;
+     xr_vector<STravelPoint>                     m_built_key_points;
+     Fvector                                     m_built_dest_position;
+     Fvector                                     m_built_dest_direction;
+ 
  private:
      IC  STravelPoint compute_better_key_point   (const STravelPoint     &point0,    const STravelPoint                  &point1,        const STravelPoint                  &point2,                bool                                reverse_order);
      IC      bool    better_key_point            (const STravelPoint     &point0,    const STravelPoint                  &point2,        const STravelPoint                  &point10,           const STravelPoint                  &point11);
@@ -167,6 +183,11 @@
              void    postprocess_key_points      (const xr_vector<u32>   &level_path,      u32                           intermediate_index,   STrajectoryPoint              &start,                   STrajectoryPoint              &dest,xr_vector<STravelParamsIndex> &finish_params,     const u32                           straight_line_index,const u32                           straight_line_index_negative);
              void    build_path_via_key_points   (STrajectoryPoint       &start,           STrajectoryPoint              &dest,                xr_vector<STravelParamsIndex> &finish_params,     const u32                           straight_line_index,const u32                           straight_line_index_negative);
              void    build_smooth_path           (const xr_vector<u32>   &level_path,      u32                           intermediate_index);
+     IC      bool    build_trajectory_cached     (const STrajectoryPoint &start,     const STrajectoryPoint              &dest,                xr_vector<STravelPathPoint>   *path,              const u32                           velocity1,          const u32                           velocity2,                  const u32               velocity3);
+     IC      bool    suffix_reusable             (const xr_vector<u32>   &level_path,      u32                           intermediate_index,   u32                           &travel_point_index,      STravelPoint                  &key_point) const;
+     IC      void    splice_suffix               (u32                    travel_point_index, const xr_vector<STravelPathPoint> &head);
+     IC      void    remember_build              (const xr_vector<u32>   &level_path);
+     IC      void    validate_trajectory_cache   ();
  
  protected:
              void    build_path                  (const xr_vector<u32> &level_path, u32 intermediate_index);
@@ -181,6 +202,7 @@
      IC      void    set_use_dest_orientation    (const bool use_dest_orientation);
      IC      void    set_state_patrol_path       (const bool state_patrol_path);
      IC      bool    state_patrol_path           () const;
+     IC      void    clear_trajectory_cache      ();
  
      friend class CScriptMonster;
      friend class CMovementManager;
@@ -209,6 +209,107 @@
      VERIFY                                      (m_movement_params.end() != I);
      return                                      ((*I).second);
  }
+ 
+ IC  bool CDetailPathManager::build_trajectory_cached(const STrajectoryPoint &start, const STrajectoryPoint &dest, xr_vector<STravelPathPoint> *path, const u32 velocity1, const u32 velocity2, const u32 velocity3)
+ {
+     validate_trajectory_cache();
+ 
+     TRAJECTORY_CACHE::CKey  key = TRAJECTORY_CACHE::key(start.vertex_id,start.direction,dest.vertex_id,dest.direction,velocity1,velocity2,velocity3);
+     const TRAJECTORY_CACHE::PATH    *cached = m_trajectory_cache.find(key,start.position,dest.position,Device.dwTimeGlobal);
+     if (cached) {
+         if (path)
+             path->insert    (path->end(),cached->begin(),cached->end());
+         return              (true);
+     }
+ 
+     m_cache_path.clear      ();
+     if (!build_trajectory(start,dest,&m_cache_path,velocity1,velocity2,velocity3))
+         return              (false);
+ 
+     m_trajectory_cache.add  (key,start.position,dest.position,m_cache_path,Device.dwTimeGlobal);
+     if (path)
+         path->insert        (path->end(),m_cache_path.begin(),m_cache_path.end());
+     return                  (true);
+ }
+ 
+ IC  void CDetailPathManager::clear_trajectory_cache   ()
+ {
+     m_trajectory_cache.clear();
+     m_built_level_path.clear();
+     m_cache_out_restrictions    = shared_str();
+     m_cache_in_restrictions     = shared_str();
+ }
+ 
+ IC  void CDetailPathManager::validate_trajectory_cache()
+ {
+     if (!m_restricted_object)
+         return;
+ 
+     // trajectories built under other restrictions may cross the new borders
+     shared_str              out_restrictions = m_restricted_object->out_restrictions();
+     shared_str              in_restrictions = m_restricted_object->in_restrictions();
+     if ((out_restrictions == m_cache_out_restrictions) && (in_restrictions == m_cache_in_restrictions))
+         return;
+ 
+     clear_trajectory_cache  ();
+     m_cache_out_restrictions    = out_restrictions;
+     m_cache_in_restrictions     = in_restrictions;
+ }
+ 
+ IC  void CDetailPathManager::remember_build     (const xr_vector<u32> &level_path)
+ {
+     m_built_level_path      = level_path;
+     m_built_key_points      = m_key_points;
+     m_built_dest_position   = m_dest_position;
+     m_built_dest_direction  = m_dest_direction;
+ }
+ 
+ IC  bool CDetailPathManager::suffix_reusable    (const xr_vector<u32> &level_path, u32 intermediate_index, u32 &travel_point_index, STravelPoint &key_point) const
+ {
+     // only the start has moved : the destination is the same and the new level path is a tail of the old one
+     if (m_failed || m_path.empty() || (m_built_key_points.size() < 2))
+         return              (false);
+ 
+     if (!m_built_dest_position.similar(m_dest_position,.1f) || !m_built_dest_direction.similar(m_dest_direction))
+         return              (false);
+ 
+     if ((intermediate_index >= level_path.size()) || (level_path.size() - intermediate_index > m_built_level_path.size()))
+         return              (false);
+ 
+     if (!std::equal(level_path.begin() + intermediate_index,level_path.end(),m_built_level_path.end() - (level_path.size() - intermediate_index)))
+         return              (false);
+ 
+     // the first old key point which is still ahead of the new start becomes the splice point
+     xr_vector<u32>::const_iterator  B = level_path.begin() + intermediate_index + 1;
+     xr_vector<u32>::const_iterator  E = level_path.end();
+     xr_vector<STravelPoint>::const_iterator I = m_built_key_points.begin() + 1;
+     xr_vector<STravelPoint>::const_iterator J = m_built_key_points.end();
+     for ( ; I != J; ++I)
+         if (std::find(B,E,(*I).vertex_id) != E)
+             break;
+ 
+     if (I == J)
+         return              (false);
+ 
+     for (u32 i=0, n=u32(m_path.size()); i<n; ++i) {
+         const STravelPathPoint  &point = m_path[i];
+         if ((point.vertex_id == (*I).vertex_id) && fsimilar(point.position.x,(*I).position.x) && fsimilar(point.position.z,(*I).position.y)) {
+             travel_point_index  = i;
+             key_point           = *I;
+             return          (true);
+         }
+     }
+ 
+     return                  (false);
+ }
+ 
+ IC  void CDetailPathManager::splice_suffix      (u32 travel_point_index, const xr_vector<STravelPathPoint> &head)
+ {
+     VERIFY                  (travel_point_index < m_path.size());
+     m_path.erase            (m_path.begin(),m_path.begin() + travel_point_index);
+     m_path.insert           (m_path.begin(),head.begin(),head.end());
+     m_current_travel_point  = 0;
+ }
 
 
 
@@ -57,6 +57,32 @@
  
      virtual void    vfLoadEF            (LPCSTR caEFFileName, CEF_Storage *tpAI_DDD);
      virtual float   ffGetValue          ();
+ 
+     IC u32          dwfGetVariableRange (u32 dwVariableIndex) const
+     {
+         return(m_dwaAtomicFeatureRange[dwVariableIndex]);
+     }
+ 
+     // evaluates dwCount candidates at once, dwpVariables holds discrete variable values laid out as [variable][candidate]
+     IC void         vfEvaluateBatch     (const u32 *dwpVariables, u32 dwCount, float *fpResults) const
+     {
+         for (u32 j=0; j<dwCount; ++j)
+             fpResults[j] = 0.f;
+ 
+         for (u32 i=0; i<m_dwPatternCount; ++i) {
+             const SPattern  &tPattern   = m_tpPatterns[i];
+             const float     *fpParameters = m_faParameters + m_dwaPatternIndexes[i];
+             const u32       *dwpFirst   = dwpVariables + tPattern.dwaVariableIndexes[0]*dwCount;
+             for (u32 j=0; j<dwCount; ++j) {
+                 u32 dwIndex = dwpFirst[j];
+                 for (u32 k=1; k<tPattern.dwCardinality; ++k) {
+                     u32 dwVariable = tPattern.dwaVariableIndexes[k];
+                     dwIndex = dwIndex*m_dwaAtomicFeatureRange[dwVariable] + dwpVariables[dwVariable*dwCount + j];
+                 }
+                 fpResults[j] += fpParameters[dwIndex];
+             }
+         }
+     }
  };
 
 
@@ -86,8 +86,94 @@
      CPatternFunction                        *m_pfBirthProbability;
      CPatternFunction                        *m_pfBirthSpeed;
  
+     // batch evaluation, the key is the function and the whole evaluation context
+     struct SBatchKey {
+         const CPatternFunction              *m_tpFunction;
+         const void                          *m_tpaContext[6];
+ 
+         IC  bool                            operator<   (const SBatchKey &tKey) const
+         {
+             if (m_tpFunction != tKey.m_tpFunction)
+                 return                      (m_tpFunction < tKey.m_tpFunction);
+             for (u32 i=0; i<6; ++i)
+                 if (m_tpaContext[i] != tKey.m_tpaContext[i])
+                     return                  (m_tpaContext[i] < tKey.m_tpaContext[i]);
+             return                          (false);
+         }
+     };
+ 
+     typedef xr_map<SBatchKey,float>                         BATCH_CACHE;
+ 
+     struct SBatchCache {
+         BATCH_CACHE                         m_tEntries;
+         u32                                 m_dwTick;
+ 
+                                             SBatchCache () : m_dwTick(u32(-1)) {}
+     };
+ 
+     SBatchCache                             m_tBatchCache;
+     xr_vector<u32>                          m_dwaBatchVariables;
+     xr_vector<u32>                          m_dwaBatchMissed;
+     xr_vector<SBatchKey>                    m_taBatchKeys;
+     xr_vector<float>                        m_faBatchResults;
+ 
                                              CEF_Storage();
      virtual                                 ~CEF_Storage();
+ 
+     IC  SBatchKey                           tBatchKey       (const CPatternFunction *tpFunction) const
+     {
+         SBatchKey                           tKey;
+         tKey.m_tpFunction                   = tpFunction;
+         tKey.m_tpaContext[0]                = m_tpGameObject;
+         tKey.m_tpaContext[1]                = m_tpCurrentMember;
+         tKey.m_tpaContext[2]                = m_tpCurrentEnemy;
+         tKey.m_tpaContext[3]                = m_tpCurrentALifeObject;
+         tKey.m_tpaContext[4]                = m_tpCurrentALifeMember;
+         tKey.m_tpaContext[5]                = m_tpCurrentALifeEnemy;
+         return                              (tKey);
+     }
+ 
+     // scores dwCount candidates against the pattern function in one pass,
+     // tpSetter(j) makes candidate j current (m_tpGameObject, m_tpCurrentEnemy, ...),
+     // results are cached by the context it establishes until dwTick changes
+     template <typename _setter_type>
+     IC  void                                vfEvaluateBatch (CPatternFunction *tpFunction, u32 dwCount, const _setter_type &tpSetter, float *fpResults, u32 dwTick)
+     {
+         if (dwTick != m_tBatchCache.m_dwTick) {
+             m_tBatchCache.m_tEntries.clear  ();
+             m_tBatchCache.m_dwTick          = dwTick;
+         }
+ 
+         m_dwaBatchMissed.clear              ();
+         for (u32 j=0; j<dwCount; ++j) {
+             tpSetter                        (j);
+             BATCH_CACHE::const_iterator     I = m_tBatchCache.m_tEntries.find(tBatchKey(tpFunction));
+             if (I != m_tBatchCache.m_tEntries.end())
+                 fpResults[j]                = (*I).second;
+             else
+                 m_dwaBatchMissed.push_back  (j);
+         }
+         if (m_dwaBatchMissed.empty())
+             return;
+ 
+         // discrete values of the primary functions, one contiguous row per variable
+         u32                                 dwMissed = u32(m_dwaBatchMissed.size());
+         m_dwaBatchVariables.resize          (tpFunction->m_dwVariableCount*dwMissed);
+         m_taBatchKeys.resize                (dwMissed);
+         for (u32 j=0; j<dwMissed; ++j) {
+             tpSetter                        (m_dwaBatchMissed[j]);
+             m_taBatchKeys[j]                = tBatchKey(tpFunction);
+             for (u32 i=0; i<tpFunction->m_dwVariableCount; ++i)
+                 m_dwaBatchVariables[i*dwMissed + j] = m_fpaBaseFunctions[tpFunction->m_dwaVariableTypes[i]]->dwfGetDiscreteValue(tpFunction->dwfGetVariableRange(i));
+         }
+ 
+         m_faBatchResults.resize             (dwMissed);
+         tpFunction->vfEvaluateBatch         (&*m_dwaBatchVariables.begin(),dwMissed,&*m_faBatchResults.begin());
+         for (u32 j=0; j<dwMissed; ++j) {
+             fpResults[m_dwaBatchMissed[j]]  = m_faBatchResults[j];
+             m_tBatchCache.m_tEntries.insert (std::make_pair(m_taBatchKeys[j],m_faBatchResults[j]));
+         }
+     }
  };
 
 
@@ -162,12 +162,17 @@
      IReader                         *m_reader;  // virtual file
      CVertex                         *m_nodes;
  
+ protected:
+     IC      void                    load_header     (IReader *reader);
+ 
  public:
  #ifndef AI_COMPILER
      IC                              CGameGraph      ();
  #else
      IC                              CGameGraph      (LPCSTR file_name, u32 current_version = XRAI_CURRENT_VERSION);
  #endif
+     // takes ownership of the reader, used to load synthetic graphs
+     IC                              CGameGraph      (IReader *reader);
      IC virtual                      ~CGameGraph     ();
      IC const CHeader                &header         () const;
      IC      bool                    mask            (const svector<ALife::_LOCATION_ID,LOCATION_TYPE_COUNT> &M, const ALife::_LOCATION_ID E[LOCATION_TYPE_COUNT]) const;
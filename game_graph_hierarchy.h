@@ -0,0 +1,90 @@
+ //  Module      : game_graph_hierarchy.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Two-level abstraction of the game graph for inter-level searches
+ 
+ #pragma once
+ 
+ #include "game_graph.h"
+ 
+ // Vertices having an edge to another level are 'portals'. For every portal
+ // a Dijkstra restricted to its level is run once and the distances (and predecessors)
+ // to every vertex of the level are stored. A journey is then searched over
+ // the small abstract graph {start, portals, goal}, and is refined into game graph
+ // vertices lazily, one level segment per call, using the stored predecessors.
+ 
+ class CGameGraphHierarchy {
+ public:
+     typedef ALife::_GRAPH_ID        _vertex_id_type;
+     typedef xr_vector<_vertex_id_type>  PATH;
+ 
+ protected:
+     enum {
+         INVALID_INDEX               = u32(-1),
+     };
+ 
+     struct CPortalRow {
+         xr_vector<float>            m_distances;    // to every vertex of the level, by local index
+         xr_vector<u32>              m_previous;     // local index of the predecessor, INVALID_INDEX at the source
+     };
+ 
+     struct CLevelData {
+         xr_vector<_vertex_id_type>  m_vertices;     // local index -> graph vertex
+         xr_vector<u32>              m_portals;      // global portal indices
+         xr_vector<CPortalRow>       m_rows;         // parallel to m_portals
+     };
+ 
+     struct CQueueItem {
+         float                       m_distance;
+         u32                         m_index;
+ 
+         IC                          CQueueItem      (float distance, u32 index) : m_distance(distance), m_index(index) {}
+ 
+         IC  bool                    operator<       (const CQueueItem &item) const
+         {
+             return                  (m_distance > item.m_distance);
+         }
+     };
+ 
+     typedef xr_map<ALife::_LEVEL_ID,CLevelData> LEVELS;
+     typedef xr_vector<CQueueItem>               QUEUE;
+ 
+ protected:
+     const CGameGraph                *m_graph;
+     LEVELS                          m_levels;
+     xr_vector<u32>                  m_local_index;  // graph vertex -> index inside its level
+     xr_vector<u32>                  m_portal_index; // graph vertex -> global portal index or INVALID_INDEX
+     xr_vector<_vertex_id_type>      m_portals;      // global portal index -> graph vertex
+     xr_vector<u32>                  m_portal_slot;  // global portal index -> index inside CLevelData::m_portals
+ 
+     // query state
+     CPortalRow                      m_start_row;
+     xr_vector<float>                m_abstract_distances;
+     xr_vector<u32>                  m_abstract_previous;
+     PATH                            m_abstract_path;
+     u32                             m_cursor;
+     QUEUE                           m_queue;
+ 
+ protected:
+     IC      const CLevelData        &level_data     (_vertex_id_type vertex_id) const;
+     IC      void                    level_search    (_vertex_id_type start_vertex_id, CPortalRow &row);
+     IC      void                    relax           (u32 index, float distance, u32 previous);
+     IC      void                    append_local    (const CPortalRow &row, _vertex_id_type finish_vertex_id, PATH &path) const;
+ 
+ public:
+     IC                              CGameGraphHierarchy ();
+     IC      void                    build           (const CGameGraph &graph);
+     IC      void                    clear           ();
+     IC      bool                    search          (_vertex_id_type start_vertex_id, _vertex_id_type goal_vertex_id);
+     IC      bool                    refine_next     (PATH &path);
+     IC      bool                    refined         () const;
+     IC      const PATH              &abstract_path  () const;
+     IC      float                   distance        () const;
+     IC      u32                     portal_count    () const;
+ };
+ 
+ #include "game_graph_hierarchy_inline.h"
+
+
+
+
@@ -0,0 +1,250 @@
+ //  Module      : game_graph_hierarchy_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Two-level abstraction of the game graph for inter-level searches inline functions
+ 
+ #pragma once
+ 
+ IC  CGameGraphHierarchy::CGameGraphHierarchy    ()
+ {
+     m_graph                 = 0;
+     m_cursor                = 0;
+ }
+ 
+ IC  const CGameGraphHierarchy::CLevelData &CGameGraphHierarchy::level_data(_vertex_id_type vertex_id) const
+ {
+     LEVELS::const_iterator  I = m_levels.find(m_graph->vertex(vertex_id)->level_id());
+     VERIFY                  (I != m_levels.end());
+     return                  ((*I).second);
+ }
+ 
+ IC  void CGameGraphHierarchy::clear             ()
+ {
+     m_levels.clear          ();
+     m_local_index.clear     ();
+     m_portal_index.clear    ();
+     m_portals.clear         ();
+     m_portal_slot.clear     ();
+     m_abstract_path.clear   ();
+     m_cursor                = 0;
+ }
+ 
+ IC  void CGameGraphHierarchy::build             (const CGameGraph &graph)
+ {
+     clear                   ();
+     m_graph                 = &graph;
+ 
+     u32                     vertex_count = graph.header().vertex_count();
+     m_local_index.assign    (vertex_count,u32(INVALID_INDEX));
+     m_portal_index.assign   (vertex_count,u32(INVALID_INDEX));
+ 
+     for (u32 i=0; i<vertex_count; ++i) {
+         CLevelData          &level = m_levels[graph.vertex(i)->level_id()];
+         m_local_index[i]    = u32(level.m_vertices.size());
+         level.m_vertices.push_back(_vertex_id_type(i));
+     }
+ 
+     // both ends of an inter-level edge are portals
+     for (u32 i=0; i<vertex_count; ++i) {
+         CGameGraph::const_iterator  I, E;
+         graph.begin         (i,I,E);
+         for ( ; I != E; ++I) {
+             u32             j = graph.value(i,I);
+             if (graph.vertex(j)->level_id() == graph.vertex(i)->level_id())
+                 continue;
+ 
+             u32             ends[2] = {i, j};
+             for (u32 k=0; k<2; ++k) {
+                 if (m_portal_index[ends[k]] != INVALID_INDEX)
+                     continue;
+ 
+                 CLevelData  &level = m_levels[graph.vertex(ends[k])->level_id()];
+                 m_portal_index[ends[k]] = u32(m_portals.size());
+                 m_portal_slot.push_back(u32(level.m_portals.size()));
+                 level.m_portals.push_back(u32(m_portals.size()));
+                 m_portals.push_back(_vertex_id_type(ends[k]));
+             }
+         }
+     }
+ 
+     LEVELS::iterator        I = m_levels.begin();
+     LEVELS::iterator        E = m_levels.end();
+     for ( ; I != E; ++I) {
+         CLevelData          &level = (*I).second;
+         level.m_rows.resize (level.m_portals.size());
+         for (u32 i=0, n=u32(level.m_portals.size()); i<n; ++i)
+             level_search    (m_portals[level.m_portals[i]],level.m_rows[i]);
+     }
+ }
+ 
+ IC  void CGameGraphHierarchy::level_search      (_vertex_id_type start_vertex_id, CPortalRow &row)
+ {
+     const CLevelData        &level = level_data(start_vertex_id);
+     ALife::_LEVEL_ID        level_id = m_graph->vertex(start_vertex_id)->level_id();
+     u32                     count = u32(level.m_vertices.size());
+ 
+     row.m_distances.assign  (count,flt_max);
+     row.m_previous.assign   (count,u32(INVALID_INDEX));
+ 
+     u32                     start = m_local_index[start_vertex_id];
+     row.m_distances[start]  = 0.f;
+     m_queue.clear           ();
+     m_queue.push_back       (CQueueItem(0.f,start));
+ 
+     while (!m_queue.empty()) {
+         std::pop_heap       (m_queue.begin(),m_queue.end());
+         CQueueItem          item = m_queue.back();
+         m_queue.pop_back    ();
+         if (item.m_distance > row.m_distances[item.m_index])
+             continue;
+ 
+         _vertex_id_type     vertex_id = level.m_vertices[item.m_index];
+         CGameGraph::const_iterator  I, E;
+         m_graph->begin      (vertex_id,I,E);
+         for ( ; I != E; ++I) {
+             u32             neighbour_id = m_graph->value(vertex_id,I);
+             if (m_graph->vertex(neighbour_id)->level_id() != level_id)
+                 continue;
+ 
+             u32             neighbour = m_local_index[neighbour_id];
+             float           distance = item.m_distance + m_graph->edge_weight(I);
+             if (distance >= row.m_distances[neighbour])
+                 continue;
+ 
+             row.m_distances[neighbour]  = distance;
+             row.m_previous[neighbour]   = item.m_index;
+             m_queue.push_back(CQueueItem(distance,neighbour));
+             std::push_heap  (m_queue.begin(),m_queue.end());
+         }
+     }
+ }
+ 
+ IC  void CGameGraphHierarchy::relax             (u32 index, float distance, u32 previous)
+ {
+     if (distance >= m_abstract_distances[index])
+         return;
+ 
+     m_abstract_distances[index] = distance;
+     m_abstract_previous[index]  = previous;
+     m_queue.push_back       (CQueueItem(distance,index));
+     std::push_heap          (m_queue.begin(),m_queue.end());
+ }
+ 
+ IC  bool CGameGraphHierarchy::search            (_vertex_id_type start_vertex_id, _vertex_id_type goal_vertex_id)
+ {
+     VERIFY                  (m_graph);
+     VERIFY                  (m_graph->valid_vertex_id(start_vertex_id) && m_graph->valid_vertex_id(goal_vertex_id));
+ 
+     m_abstract_path.clear   ();
+     m_cursor                = 0;
+ 
+     // abstract vertices : portals, then start, then goal
+     u32                     start = u32(m_portals.size());
+     u32                     goal = start + 1;
+     ALife::_LEVEL_ID        goal_level_id = m_graph->vertex(goal_vertex_id)->level_id();
+ 
+     level_search            (start_vertex_id,m_start_row);
+ 
+     m_abstract_distances.assign(goal + 1,flt_max);
+     m_abstract_previous.assign(goal + 1,u32(INVALID_INDEX));
+     m_abstract_distances[start] = 0.f;
+     m_queue.clear           ();
+     m_queue.push_back       (CQueueItem(0.f,start));
+ 
+     while (!m_queue.empty()) {
+         std::pop_heap       (m_queue.begin(),m_queue.end());
+         CQueueItem          item = m_queue.back();
+         m_queue.pop_back    ();
+         if (item.m_distance > m_abstract_distances[item.m_index])
+             continue;
+ 
+         if (item.m_index == goal)
+             break;
+ 
+         _vertex_id_type     vertex_id = (item.m_index == start) ? start_vertex_id : m_portals[item.m_index];
+         const CLevelData    &level = level_data(vertex_id);
+         const CPortalRow    &row = (item.m_index == start) ? m_start_row : level.m_rows[m_portal_slot[item.m_index]];
+ 
+         xr_vector<u32>::const_iterator  I = level.m_portals.begin();
+         xr_vector<u32>::const_iterator  E = level.m_portals.end();
+         for ( ; I != E; ++I)
+             if (*I != item.m_index)
+                 relax       (*I,item.m_distance + row.m_distances[m_local_index[m_portals[*I]]],item.m_index);
+ 
+         if (m_graph->vertex(vertex_id)->level_id() == goal_level_id)
+             relax           (goal,item.m_distance + row.m_distances[m_local_index[goal_vertex_id]],item.m_index);
+ 
+         if (item.m_index == start)
+             continue;
+ 
+         CGameGraph::const_iterator  i, e;
+         m_graph->begin      (vertex_id,i,e);
+         for ( ; i != e; ++i) {
+             u32             neighbour_id = m_graph->value(vertex_id,i);
+             if (m_graph->vertex(neighbour_id)->level_id() != m_graph->vertex(vertex_id)->level_id())
+                 relax       (m_portal_index[neighbour_id],item.m_distance + m_graph->edge_weight(i),item.m_index);
+         }
+     }
+ 
+     if (m_abstract_distances[goal] == flt_max)
+         return              (false);
+ 
+     for (u32 i=goal; i != INVALID_INDEX; i = m_abstract_previous[i])
+         m_abstract_path.push_back((i == goal) ? goal_vertex_id : ((i == start) ? start_vertex_id : m_portals[i]));
+     std::reverse            (m_abstract_path.begin(),m_abstract_path.end());
+ 
+     return                  (true);
+ }
+ 
+ IC  void CGameGraphHierarchy::append_local      (const CPortalRow &row, _vertex_id_type finish_vertex_id, PATH &path) const
+ {
+     const CLevelData        &level = level_data(finish_vertex_id);
+     u32                     size = u32(path.size());
+     for (u32 i=m_local_index[finish_vertex_id]; row.m_previous[i] != INVALID_INDEX; i = row.m_previous[i])
+         path.push_back      (level.m_vertices[i]);
+     std::reverse            (path.begin() + size,path.end());
+ }
+ 
+ IC  bool CGameGraphHierarchy::refine_next       (PATH &path)
+ {
+     if (refined())
+         return              (false);
+ 
+     _vertex_id_type         vertex_id = m_abstract_path[m_cursor];
+     _vertex_id_type         next_vertex_id = m_abstract_path[m_cursor + 1];
+     if (!m_cursor)
+         path.push_back      (vertex_id);
+ 
+     if (m_graph->vertex(vertex_id)->level_id() != m_graph->vertex(next_vertex_id)->level_id())
+         path.push_back      (next_vertex_id);
+     else
+         append_local        (m_cursor ? level_data(vertex_id).m_rows[m_portal_slot[m_portal_index[vertex_id]]] : m_start_row,next_vertex_id,path);
+ 
+     ++m_cursor;
+     return                  (true);
+ }
+ 
+ IC  bool CGameGraphHierarchy::refined           () const
+ {
+     return                  (m_cursor + 1 >= m_abstract_path.size());
+ }
+ 
+ IC  const CGameGraphHierarchy::PATH &CGameGraphHierarchy::abstract_path() const
+ {
+     return                  (m_abstract_path);
+ }
+ 
+ IC  float CGameGraphHierarchy::distance         () const
+ {
+     VERIFY                  (!m_abstract_path.empty());
+     return                  (m_abstract_distances.back());
+ }
+ 
+ IC  u32 CGameGraphHierarchy::portal_count       () const
+ {
+     return                  (u32(m_portals.size()));
+ }
+
+
+
+
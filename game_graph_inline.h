@@ -17,7 +17,27 @@
      string256                   file_name;
      FS.update_path              (file_name,"$game_data$",GRAPH_NAME);
  #endif  
-     m_reader                    = FS.r_open(file_name);
+     load_header                 (FS.r_open(file_name));
+ #ifndef AI_COMPILER
+     R_ASSERT2                   (header().version() == XRAI_CURRENT_VERSION,"Graph version mismatch!");
+ #else
+     if (XRAI_CURRENT_VERSION != current_version)
+         if (header().version() != current_version)
+             return;
+ #endif
+     m_nodes                     = (CVertex*)m_reader->pointer();
+ }
+ 
+ IC CGameGraph::CGameGraph       (IReader *reader)
+ {
+     load_header                 (reader);
+     R_ASSERT2                   (header().version() == XRAI_CURRENT_VERSION,"Graph version mismatch!");
+     m_nodes                     = (CVertex*)m_reader->pointer();
+ }
+ 
+ IC void CGameGraph::load_header (IReader *reader)
+ {
+     m_reader                    = reader;
      m_header.dwVersion          = m_reader->r_u32();
      m_header.dwLevelCount       = m_reader->r_u32();
      m_header.dwVertexCount      = m_reader->r_u32();
@@ -32,14 +52,6 @@
          m_reader->r_stringZ     (l_tLevel.m_section);
          m_header.tpLevels.insert(mk_pair(l_tLevel.tLevelID,l_tLevel));
      }
- #ifndef AI_COMPILER
-     R_ASSERT2                   (header().version() == XRAI_CURRENT_VERSION,"Graph version mismatch!");
- #else
-     if (XRAI_CURRENT_VERSION != current_version)
-         if (header().version() != current_version)
-             return;
- #endif
-     m_nodes                     = (CVertex*)m_reader->pointer();
  }
  
  IC CGameGraph::~CGameGraph          ()
@@ -19,6 +19,9 @@
  
  #define CROSS_TABLE_CHUNK_VERSION           0
  #define CROSS_TABLE_CHUNK_DATA              1
+ #define CROSS_TABLE_CHUNK_COMPRESSED        2
+ 
+ #define CROSS_TABLE_BLOCK_SHIFT             6
  
  class CGameLevelCrossTable {
  public:
@@ -44,6 +47,7 @@
      public:
          IC  ALife::_GRAPH_ID game_vertex_id         () const;
          IC  float           distance                () const;
+         friend class CGameLevelCrossTable;
  #ifdef AI_COMPILER      
          friend class CLevelGameGraph;
          friend class CCrossTableBuilder;
@@ -52,20 +56,58 @@
      };
      #pragma pack(pop)
  
+     // Runtime layout : level vertices map to runs of the same game vertex,
+     // a block index (one entry per 1 << block_shift level vertices) points to the run
+     // covering the first vertex of the block, so a lookup scans at most one block of runs.
+     // Distances are quantized to u16. The blob is position independent and is used
+     // in place when the file carries CROSS_TABLE_CHUNK_COMPRESSED,
+     // so mapped files are shared between server instances.
+     //
+     // CCompressedHeader | u32 block_runs[block_count] | u32 run_starts[run_count] | _GRAPH_ID run_vertices[run_count] | u16 distances[level_vertex_count]
+     struct CCompressedHeader {
+         u32                 block_shift;
+         u32                 level_vertex_count;
+         u32                 run_count;
+         float               distance_scale;
+     };
+ 
  protected:
      CHeader                 m_tCrossTableHeader;
      IReader                 *m_tpCrossTableVFS;
      CCell                   *m_tpaCrossTable;
  
+ #ifndef AI_COMPILER
+     xr_vector<u8>           m_compressed_buffer;
+     const CCompressedHeader *m_compressed;
+     const u32               *m_block_runs;
+     const u32               *m_run_starts;
+     const ALife::_GRAPH_ID  *m_run_vertices;
+     const u16               *m_distances;
+ 
+ protected:
+     IC      void            bind                    (const void *data);
+     IC      void            load                    (IReader *stream);
+ #endif
+ 
+ public:
+     IC static void          compress                (const CCell *cells, u32 cell_count, xr_vector<u8> &buffer);
+ 
  public:
  #ifdef AI_COMPILER
      IC                      CGameLevelCrossTable    (LPCSTR fName, u32 current_version = XRAI_CURRENT_VERSION);
  #else
      IC                      CGameLevelCrossTable    ();
+     // takes the opened file, so it can be decoded outside of the FS calls
+     IC                      CGameLevelCrossTable    (IReader *stream);
  #endif
      IC virtual              ~CGameLevelCrossTable   ();
-     IC      const CCell     &vertex                 (u32 level_vertex_id) const;
      IC      const CHeader   &header                 () const;
+ #ifdef AI_COMPILER
+     IC      const CCell     &vertex                 (u32 level_vertex_id) const;
+ #else
+     IC      CCell           vertex                  (u32 level_vertex_id) const;
+     IC      u32             memory_usage            () const;
+ #endif
  #ifdef AI_COMPILER      
      friend class CLevelGameGraph;
      friend class CCrossTableBuilder;
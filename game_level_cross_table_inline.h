@@ -9,15 +9,25 @@
  
  #ifdef AI_COMPILER
  IC CGameLevelCrossTable::CGameLevelCrossTable(LPCSTR fName, u32 current_version)
+ {
+     m_tpCrossTableVFS                   = FS.r_open(fName);
  #else
  IC CGameLevelCrossTable::CGameLevelCrossTable()
- #endif
  {
- #ifndef AI_COMPILER
      string256                           fName;
      FS.update_path                      (fName,"$level$",CROSS_TABLE_NAME);
+     load                                (FS.r_open(fName));
+ }
+ 
+ IC CGameLevelCrossTable::CGameLevelCrossTable(IReader *stream)
+ {
+     load                                (stream);
+ }
+ 
+ IC void CGameLevelCrossTable::load      (IReader *stream)
+ {
+     m_tpCrossTableVFS                   = stream;
  #endif
-     m_tpCrossTableVFS                   = FS.r_open(fName);
      R_ASSERT2                           (m_tpCrossTableVFS,"Can't open cross table!");
      R_ASSERT2                           (m_tpCrossTableVFS->find_chunk(CROSS_TABLE_CHUNK_VERSION),"Can't find chunk CROSS_TABLE_CHUNK_VERSION!");
      m_tpCrossTableVFS->open_chunk       (CROSS_TABLE_CHUNK_VERSION);
@@ -28,10 +38,25 @@
              return;
  #else
      R_ASSERT2                           (m_tCrossTableHeader.version() == XRAI_CURRENT_VERSION,"Cross table version mismatch!");
+ 
+     if (m_tpCrossTableVFS->find_chunk(CROSS_TABLE_CHUNK_COMPRESSED)) {
+         // precompressed table is used right from the mapped file
+         m_tpCrossTableVFS->open_chunk   (CROSS_TABLE_CHUNK_COMPRESSED);
+         m_tpaCrossTable                 = 0;
+         bind                            (m_tpCrossTableVFS->pointer());
+         return;
+     }
  #endif
      R_ASSERT2                           (m_tpCrossTableVFS->find_chunk(CROSS_TABLE_CHUNK_DATA),"Can't find chunk CROSS_TABLE_CHUNK_DATA!");
      m_tpCrossTableVFS->open_chunk       (CROSS_TABLE_CHUNK_DATA);
      m_tpaCrossTable                     = (CCell*)m_tpCrossTableVFS->pointer();
+ #ifndef AI_COMPILER
+     // compress the flat table and drop the file
+     compress                            (m_tpaCrossTable,header().level_vertex_count(),m_compressed_buffer);
+     m_tpaCrossTable                     = 0;
+     xr_delete                           (m_tpCrossTableVFS);
+     bind                                (&*m_compressed_buffer.begin());
+ #endif
  };
  
  IC CGameLevelCrossTable::~CGameLevelCrossTable()
@@ -39,10 +64,82 @@
      xr_delete                           (m_tpCrossTableVFS);
  };
  
+ IC void CGameLevelCrossTable::compress(const CCell *cells, u32 cell_count, xr_vector<u8> &buffer)
+ {
+     float                               max_distance = 0.f;
+     xr_vector<u32>                      run_starts;
+     xr_vector<ALife::_GRAPH_ID>         run_vertices;
+     for (u32 i=0; i<cell_count; ++i) {
+         max_distance                    = _max(max_distance,cells[i].distance());
+         if (run_vertices.empty() || (run_vertices.back() != cells[i].game_vertex_id())) {
+             run_starts.push_back        (i);
+             run_vertices.push_back      (cells[i].game_vertex_id());
+         }
+     }
+ 
+     u32                                 run_count = u32(run_starts.size());
+     u32                                 block_count = (cell_count >> CROSS_TABLE_BLOCK_SHIFT) + 1;
+     buffer.resize                       (sizeof(CCompressedHeader) + (block_count + run_count)*sizeof(u32) + run_count*sizeof(ALife::_GRAPH_ID) + cell_count*sizeof(u16));
+ 
+     CCompressedHeader                   *compressed = (CCompressedHeader*)&*buffer.begin();
+     compressed->block_shift             = CROSS_TABLE_BLOCK_SHIFT;
+     compressed->level_vertex_count      = cell_count;
+     compressed->run_count               = run_count;
+     compressed->distance_scale          = (max_distance > 0.f) ? max_distance/65535.f : 1.f;
+ 
+     u32                                 *block_runs = (u32*)(compressed + 1);
+     u32                                 *starts = block_runs + block_count;
+     ALife::_GRAPH_ID                    *vertices = (ALife::_GRAPH_ID*)(starts + run_count);
+     u16                                 *distances = (u16*)(vertices + run_count);
+ 
+     for (u32 i=0, j=0; i<block_count; ++i) {
+         u32                             first = i << CROSS_TABLE_BLOCK_SHIFT;
+         for ( ; (j + 1 < run_count) && (run_starts[j + 1] <= first); ++j);
+         block_runs[i]                   = j;
+     }
+ 
+     if (run_count) {
+         std::copy                       (run_starts.begin(),run_starts.end(),starts);
+         std::copy                       (run_vertices.begin(),run_vertices.end(),vertices);
+     }
+ 
+     for (u32 i=0; i<cell_count; ++i)
+         distances[i]                    = u16(iFloor(cells[i].distance()/compressed->distance_scale + .5f));
+ }
+ 
+ #ifdef AI_COMPILER
  IC const CGameLevelCrossTable::CCell &CGameLevelCrossTable::vertex(u32 level_vertex_id) const
  {
      return                              (m_tpaCrossTable[level_vertex_id]);
  }
+ #else
+ IC void CGameLevelCrossTable::bind      (const void *data)
+ {
+     m_compressed                        = (const CCompressedHeader*)data;
+     R_ASSERT2                           (m_compressed->level_vertex_count == header().level_vertex_count(),"Compressed cross table doesn't match its header!");
+     m_block_runs                        = (const u32*)(m_compressed + 1);
+     m_run_starts                        = m_block_runs + (m_compressed->level_vertex_count >> m_compressed->block_shift) + 1;
+     m_run_vertices                      = (const ALife::_GRAPH_ID*)(m_run_starts + m_compressed->run_count);
+     m_distances                         = (const u16*)(m_run_vertices + m_compressed->run_count);
+ }
+ 
+ IC CGameLevelCrossTable::CCell CGameLevelCrossTable::vertex(u32 level_vertex_id) const
+ {
+     VERIFY                              (level_vertex_id < m_compressed->level_vertex_count);
+     u32                                 run = m_block_runs[level_vertex_id >> m_compressed->block_shift];
+     for ( ; (run + 1 < m_compressed->run_count) && (m_run_starts[run + 1] <= level_vertex_id); ++run);
+ 
+     CCell                               result;
+     result.tGraphIndex                  = m_run_vertices[run];
+     result.fDistance                    = float(m_distances[level_vertex_id])*m_compressed->distance_scale;
+     return                              (result);
+ }
+ 
+ IC u32 CGameLevelCrossTable::memory_usage() const
+ {
+     return                              (u32((const u8*)(m_distances + m_compressed->level_vertex_count) - (const u8*)m_compressed));
+ }
+ #endif
  
  IC  u32 CGameLevelCrossTable::CHeader::version() const
  {
@@ -22,6 +22,7 @@
  #include "vertex_allocator_fixed.h"
  //      priority queues
  #include "data_storage_bucket_list.h"
+ #include "data_storage_radix_heap.h"
  //#include "data_storage_cheap_list.h"
  //#include "data_storage_single_linked_list.h"
  //#include "data_storage_double_linked_list.h"
@@ -79,7 +80,12 @@
  //  typedef CDataStorageCheapList<32,true,true>             CSolverPriorityQueue;
  //  typedef CDataStorageDoubleLinkedList<true>              CSolverPriorityQueue;
      typedef CDataStorageBinaryHeap                          CSolverPriorityQueue;
+ // define GRAPH_ENGINE_BUCKET_LIST to compare Device.Statistic.AI_Path against the bucket list
+ #ifdef GRAPH_ENGINE_BUCKET_LIST
      typedef CDataStorageBucketList<u32,u32,8*1024,false>    CPriorityQueue;
+ #else
+     typedef CDataStorageRadixHeap<1024>                     CPriorityQueue;
+ #endif
  //  typedef CDataStorageBinaryHeap                          CPriorityQueue;
  //  typedef CDataStorageBinaryHeapList<4>                   CPriorityQueue;
  //  typedef CDataStorageMultiBinaryHeap<4>                  CPriorityQueue;
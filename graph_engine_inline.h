@@ -10,8 +10,10 @@
  IC  CGraphEngine::CGraphEngine      (u32 max_vertex_count)
  {
      m_algorithm         = xr_new<CAlgorithm>                (max_vertex_count);
+ #ifdef GRAPH_ENGINE_BUCKET_LIST
      m_algorithm->data_storage().set_min_bucket_value        (_dist_type(0));
      m_algorithm->data_storage().set_max_bucket_value        (_dist_type(2000));
+ #endif
      m_solver_algorithm  = xr_new<CSolverAlgorithm>          (16*1024);
  }
  
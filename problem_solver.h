@@ -7,6 +7,8 @@
  
  #pragma once
  
+ #include "dense_id_map.h"
+ 
  template <
      typename _operator_condition,
      typename _condition_state,
@@ -58,7 +60,13 @@
      };
      typedef xr_vector<SOperator>                                    OPERATOR_VECTOR;
      typedef typename OPERATOR_VECTOR::const_iterator                const_iterator;
-     typedef xr_map<_condition_type,_condition_evaluator_ptr>        EVALUATOR_MAP;
+     typedef CDenseIdMap<_condition_type,_condition_evaluator_ptr>   EVALUATOR_MAP;
+ 
+     struct SEvaluation {
+         u32                 m_tick;
+         _value_type         m_value;
+     };
+     typedef xr_vector<SEvaluation>                                  EVALUATIONS;
  
  protected:
      OPERATOR_VECTOR             m_operators;
@@ -71,6 +79,12 @@
      bool                        m_actuality;
      bool                        m_solution_changed;
      bool                        m_failed;
+     // evaluator results are computed once per 'solve' call, indexed as EVALUATOR_MAP positions
+     mutable EVALUATIONS         m_evaluations;
+     u32                         m_evaluation_tick;
+     // when no more conditions than this flip, the previous solution is verified instead of searching again
+     u32                         m_max_flipped_conditions;
+     xr_vector<_condition_type>  m_flipped;
  
  private:
      template <bool>
@@ -93,6 +107,10 @@
  #ifdef DEBUG
      IC      void                        validate_properties     (const CState &conditions) const;
  #endif
+     IC      void                        reset_evaluations       ();
+     IC      bool                        solution_valid          ();
+     IC      bool                        flipped_unused          () const;
+     IC      void                        refresh_current_state   ();
  
  
  public:
@@ -128,12 +146,14 @@
      IC      void                        add_evaluator           (const _condition_type &condition_id, _condition_evaluator_ptr evaluator);
      IC      void                        remove_evaluator        (const _condition_type &condition_id);
      IC      _condition_evaluator_ptr    evaluator               (const _condition_type &condition_id) const;
+     IC      _value_type                 evaluate                (const _condition_type &condition_id) const;
      IC      const EVALUATOR_MAP         &evaluators             () const;
      IC      void                        evaluate_condition      (typename xr_vector<COperatorCondition>::const_iterator &I, typename xr_vector<COperatorCondition>::const_iterator &E, const _condition_type &condition_id) const;
  
      // solver interface
      IC      void                        solve                   ();
      IC      const xr_vector<_edge_type> &solution               () const;
+     IC      void                        set_max_flipped_conditions(u32 count);
      virtual void                        clear                   ();
  };
  
@@ -55,6 +55,8 @@
  TEMPLATE_SPECIALIZATION
  void CProblemSolverAbstract::init                       ()
  {
+     m_evaluation_tick       = 1;
+     m_max_flipped_conditions= 2;
  }
  
  TEMPLATE_SPECIALIZATION
@@ -156,6 +158,7 @@
  {
      VERIFY                      (m_evaluators.find(condition_id) == m_evaluators.end());
      m_evaluators.insert         (std::make_pair(condition_id,evaluator));
+     reset_evaluations           ();
  }
  
  TEMPLATE_SPECIALIZATION
@@ -166,6 +169,29 @@
      delete_data                 ((*I).second);
      m_evaluators.erase          (I);
      m_actuality                 = false;
+     reset_evaluations           ();
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CProblemSolverAbstract::reset_evaluations          ()
+ {
+     SEvaluation                 evaluation;
+     evaluation.m_tick           = 0;
+     evaluation.m_value          = _value_type();
+     m_evaluations.assign        (m_evaluators.size(),evaluation);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CProblemSolverAbstract::_value_type CProblemSolverAbstract::evaluate    (const _condition_type &condition_id) const
+ {
+     u32                         index = m_evaluators.position(condition_id);
+     VERIFY                      (index < m_evaluations.size());
+     SEvaluation                 &evaluation = m_evaluations[index];
+     if (evaluation.m_tick != m_evaluation_tick) {
+         evaluation.m_value      = (*(m_evaluators.begin() + index)).second->evaluate();
+         evaluation.m_tick       = m_evaluation_tick;
+     }
+     return                      (evaluation.m_value);
  }
  
  TEMPLATE_SPECIALIZATION
@@ -185,10 +211,8 @@
  TEMPLATE_SPECIALIZATION
  IC  void CProblemSolverAbstract::evaluate_condition         (typename xr_vector<COperatorCondition>::const_iterator &I, typename xr_vector<COperatorCondition>::const_iterator &E, const _condition_type &condition_id) const
  {
-     EVALUATOR_MAP::const_iterator   J = m_evaluators.find(condition_id);
-     VERIFY                          (J != m_evaluators.end());
      size_t                          index = I - m_current_state.conditions().begin();
-     m_current_state.add_condition   (I,COperatorCondition(condition_id,(*J).second->evaluate()));
+     m_current_state.add_condition   (I,COperatorCondition(condition_id,evaluate(condition_id)));
      I                               = m_current_state.conditions().begin() + index;
      E                               = m_current_state.conditions().end();
  }
@@ -337,25 +361,95 @@
      return                      ((*I).get_operator());
  }
  
+ TEMPLATE_SPECIALIZATION
+ IC  void CProblemSolverAbstract::set_max_flipped_conditions (u32 count)
+ {
+     m_max_flipped_conditions    = count;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CProblemSolverAbstract::flipped_unused             () const
+ {
+     // no operator depends on or changes the flipped conditions, so the search space is the same as before
+     OPERATOR_VECTOR::const_iterator I = m_operators.begin();
+     OPERATOR_VECTOR::const_iterator E = m_operators.end();
+     for ( ; I != E; ++I) {
+         const CState            *states[2] = {&(*I).m_operator->conditions(),&(*I).m_operator->effects()};
+         for (u32 j=0; j<2; ++j) {
+             xr_vector<COperatorCondition>::const_iterator   i = states[j]->conditions().begin();
+             xr_vector<COperatorCondition>::const_iterator   e = states[j]->conditions().end();
+             for ( ; i != e; ++i)
+                 if (std::binary_search(m_flipped.begin(),m_flipped.end(),(*i).condition()))
+                     return      (false);
+         }
+     }
+     return                      (true);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CProblemSolverAbstract::refresh_current_state      ()
+ {
+     // evaluations are cached for the tick, so this costs a lookup per condition
+     m_temp.clear                ();
+     xr_vector<COperatorCondition>::const_iterator   I = m_current_state.conditions().begin();
+     xr_vector<COperatorCondition>::const_iterator   E = m_current_state.conditions().end();
+     for ( ; I != E; ++I)
+         m_temp.add_condition_back(COperatorCondition((*I).condition(),evaluate((*I).condition())));
+     m_current_state             = m_temp;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CProblemSolverAbstract::solution_valid             ()
+ {
+     // replays the previous solution from the search start vertex (empty state, conditions come from the current state on demand);
+     // the replay is accepted only while it is still optimal : either the flipped conditions are not used by any operator,
+     // or its cost reaches the heuristic lower bound of the search
+     bool                        unused = flipped_unused();
+     CState                      vertex;
+     _edge_value_type            lower_bound = estimate_edge_weight(vertex);
+     _edge_value_type            cost = 0;
+     xr_vector<_edge_type>::const_iterator   I = m_solution.begin();
+     xr_vector<_edge_type>::const_iterator   E = m_solution.end();
+     for ( ; I != E; ++I) {
+         _operator_ptr           _operator = get_operator(*I);
+         if (!_operator->applicable(vertex,current_state(),_operator->conditions(),*this))
+             return              (false);
+         _operator->apply        (vertex,_operator->effects(),m_temp,m_current_state,*this);
+         cost                    += _operator->weight(m_temp,vertex);
+         vertex                  = m_temp;
+     }
+     if (!is_goal_reached(vertex))
+         return                  (false);
+     return                      (unused || (cost <= lower_bound));
+ }
+ 
  TEMPLATE_SPECIALIZATION
  IC  void CProblemSolverAbstract::solve          ()
  {
  #ifndef AI_COMPILER
      m_solution_changed          = false;
+     ++m_evaluation_tick;
      if (m_actuality) {
-         bool                    actual = true;
+         m_flipped.clear         ();
          xr_vector<COperatorCondition>::const_iterator   I = current_state().conditions().begin();
          xr_vector<COperatorCondition>::const_iterator   E = current_state().conditions().end();
          for ( ; I != E; ++I) {
-             EVALUATOR_MAP::const_iterator J = evaluators().find((*I).condition());
-             VERIFY              (evaluators().end() != J);
-             if ((*J).second->evaluate() != (*I).value()) {
-                 actual          = false;
-                 break;
+             if (evaluate((*I).condition()) != (*I).value()) {
+                 m_flipped.push_back((*I).condition());
+                 if (m_flipped.size() > m_max_flipped_conditions)
+                     break;
              }
          }
-         if (actual)
+         if (m_flipped.empty())
              return;
+ 
+         // incremental replanning : a few flipped conditions often leave the previous plan valid and optimal,
+         // the whole current state is re-evaluated so the next flip detection sees every condition
+         if (!reverse_search && !m_failed && !m_solution.empty() && (m_flipped.size() <= m_max_flipped_conditions)) {
+             refresh_current_state   ();
+             if (solution_valid())
+                 return;
+         }
      }
  
      m_actuality                 = true;
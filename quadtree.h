@@ -90,8 +90,10 @@
      CQuadNodeStorage            *m_nodes;
      CListItemStorage            *m_list_items;
      size_t                      m_leaf_count;
+     u32                         m_stamp;        // unique among all the trees, renewed on every change
  
  protected:
+     IC  static u32              next_stamp      ();
      IC      u32                 neighbour_index (const Fvector  &position,  Fvector &center, float distance) const;
      IC      void                nearest         (const Fvector  &position,  float radius, xr_vector<_object_type*> &objects, CQuadNode *node, Fvector center, float distance, int depth) const;
      IC      _object_type        *remove         (const _object_type *object,CQuadNode *&node, Fvector center, float distance, int depth);
@@ -107,6 +109,7 @@
      IC      void                nearest         (const Fvector  &position,  float radius, xr_vector<_object_type*> &objects, bool clear = true) const;
      IC      void                all             (xr_vector<_object_type*> &objects, bool clear = true) const;
      IC      size_t              size            () const;
+     IC      u32                 stamp           () const;
  };
  
  #include "quadtree_inline.h"
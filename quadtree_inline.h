@@ -25,6 +25,7 @@
      m_nodes             = xr_new<CQuadNodeStorage>(max_node_count);
      m_list_items        = xr_new<CListItemStorage>(max_list_item_count);
      m_root              = 0;
+     m_stamp             = next_stamp();
  }
  
  TEMPLATE_SPECIALIZATION
@@ -44,6 +45,7 @@
      m_list_items->clear ();
      m_root              = 0;
      m_leaf_count        = 0;
+     m_stamp             = next_stamp();
  #ifndef AI_COMPILER
      Device.Statistic.AI_Range.End();
  #endif
@@ -55,6 +57,19 @@
      return              (m_leaf_count);
  }
  
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CSQuadTree::stamp   () const
+ {
+     return              (m_stamp);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CSQuadTree::next_stamp  ()
+ {
+     static u32          stamp = 0;
+     return              (++stamp);
+ }
+ 
  TEMPLATE_SPECIALIZATION
  IC  u32 CSQuadTree::neighbour_index (const Fvector &position, Fvector &center, float distance) const
  {
@@ -88,6 +103,7 @@
  #ifndef AI_COMPILER
      Device.Statistic.AI_Range.Begin();
  #endif
+     m_stamp             = next_stamp();
      Fvector             center = m_center;
      float               distance = m_radius;
      CQuadNode           **node = &m_root;
@@ -239,6 +255,7 @@
  #ifndef AI_COMPILER
      Device.Statistic.AI_Range.Begin();
  #endif
+     m_stamp             = next_stamp();
      _object_type    *_object = remove(object,m_root,m_center,m_radius,0);
  #ifndef AI_COMPILER
      Device.Statistic.AI_Range.End();
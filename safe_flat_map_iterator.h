@@ -0,0 +1,138 @@
+ //  Module      : safe_flat_map_iterator.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Safe map iterator template over a flat sorted container
+ 
+ #pragma once
+ 
+ // The same interface as CSafeMapIterator, but the objects are kept in a vector sorted by key.
+ // Removal only clears the pointer (a tombstone), so positions stay valid while the registry
+ // is iterated in time slices, and the tombstones are compacted at the start of the next update
+ // when there are enough of them. Insertion shifts the tail, so the iterator passed to an update
+ // predicate must not be used after the predicate has added objects.
+ 
+ template <
+     typename _key_type,
+     typename _data_type,
+     typename _predicate = std::less<_key_type>
+ >
+ class CFlatSortedRegistry {
+ public:
+     typedef std::pair<_key_type,_data_type*>    value_type;
+     typedef xr_vector<value_type>               STORAGE;
+ 
+     template <typename _storage_iterator, typename _value_type>
+     class CIterator {
+     public:
+         typedef std::forward_iterator_tag                                               iterator_category;
+         typedef typename std::iterator_traits<_storage_iterator>::value_type            value_type;
+         typedef typename std::iterator_traits<_storage_iterator>::difference_type       difference_type;
+         typedef _value_type                                                             *pointer;
+         typedef _value_type                                                             &reference;
+ 
+     protected:
+         _storage_iterator   m_current;
+         _storage_iterator   m_end;
+ 
+     protected:
+         IC  void            skip                () {for ( ; (m_current != m_end) && !(*m_current).second; ++m_current);}
+ 
+     public:
+         IC                  CIterator           () {}
+         IC                  CIterator           (_storage_iterator current, _storage_iterator end) : m_current(current), m_end(end) {skip();}
+         template <typename _other_iterator, typename _other_value_type>
+         IC                  CIterator           (const CIterator<_other_iterator,_other_value_type> &iterator) : m_current(iterator.base()), m_end(iterator.base_end()) {}
+         IC  _value_type     &operator*          () const {return(*m_current);}
+         IC  _value_type     *operator->         () const {return(&*m_current);}
+         IC  CIterator       &operator++         () {++m_current; skip(); return(*this);}
+         IC  CIterator       operator++          (int) {CIterator temp = *this; ++*this; return(temp);}
+         IC  bool            operator==          (const CIterator &iterator) const {return(m_current == iterator.m_current);}
+         IC  bool            operator!=          (const CIterator &iterator) const {return(m_current != iterator.m_current);}
+         IC  _storage_iterator   base            () const {return(m_current);}
+         IC  _storage_iterator   base_end        () const {return(m_end);}
+     };
+ 
+     typedef CIterator<typename STORAGE::iterator,value_type>                iterator;
+     typedef CIterator<typename STORAGE::const_iterator,const value_type>    const_iterator;
+ 
+ protected:
+     struct CKeyPredicate {
+         IC  bool            operator()          (const value_type &value, const _key_type &key) const
+         {
+             return          (_predicate()(value.first,key));
+         }
+     };
+ 
+ protected:
+     STORAGE                 m_storage;
+     u32                     m_dead_count;
+ 
+ protected:
+     IC  typename STORAGE::iterator  lower_bound (const _key_type &key);
+ 
+ public:
+     IC                      CFlatSortedRegistry ();
+     IC  iterator            begin               ();
+     IC  iterator            end                 ();
+     IC  const_iterator      begin               () const;
+     IC  const_iterator      end                 () const;
+     IC  iterator            find                (const _key_type &key);
+     IC  const_iterator      find                (const _key_type &key) const;
+     IC  std::pair<iterator,bool>    insert      (const value_type &value);
+     IC  void                erase               (iterator I);
+     IC  void                clear               ();
+     IC  u32                 size                () const;
+     IC  bool                empty               () const;
+     IC  bool                fragmented          () const;
+     IC  void                compact             ();
+     IC  u32                 position            (const_iterator I) const;
+     IC  iterator            at                  (u32 position);
+     IC  u32                 capacity            () const;
+ };
+ 
+ template <
+     typename _key_type,
+     typename _data_type,
+     typename _predicate = std::less<_key_type>,
+     typename _cycle_type = u64,
+     bool     use_first_update = true
+ >
+ class CSafeFlatMapIterator {
+ public:
+     typedef CFlatSortedRegistry<_key_type,_data_type,_predicate>    _REGISTRY;
+     typedef typename _REGISTRY::iterator                            _iterator;
+     typedef typename _REGISTRY::const_iterator                      _const_iterator;
+ 
+ protected:
+     _REGISTRY               m_objects;
+     _cycle_type             m_cycle_count;
+     u32                     m_next_position;    // position in the storage, tombstones included
+     u64                     m_start_time;
+     u64                     m_max_process_time;
+     bool                    m_first_update;
+ 
+ protected:
+     IC      void            update_next         ();
+     IC      _iterator       next                ();
+     IC      void            start_timer         ();
+     IC      bool            time_over           ();
+ 
+ public:
+     IC                      CSafeFlatMapIterator();
+     virtual                 ~CSafeFlatMapIterator();
+     IC      void            add                 (const _key_type &id, _data_type *value, bool no_assert = false);
+     IC      void            remove              (const _key_type &id, bool no_assert = false);
+     template <typename _update_predicate>
+     IC      u32             update              (const _update_predicate &predicate);
+     IC      void            set_process_time    (const u64 &process_time);
+     IC      const _REGISTRY &objects            () const;
+     IC      void            clear               ();
+     IC      bool            empty               () const;
+     IC      void            begin               ();
+ };
+ 
+ #include "safe_flat_map_iterator_inline.h"
+
+
+
+
@@ -0,0 +1,308 @@
+ //  Module      : safe_flat_map_iterator_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Safe map iterator template over a flat sorted container inline functions
+ 
+ #pragma once
+ 
+ #define TEMPLATE_SPECIALIZATION \
+     template <\
+         typename _key_type,\
+         typename _data_type,\
+         typename _predicate\
+     >
+ 
+ #define CSFlatSortedRegistry    CFlatSortedRegistry<_key_type,_data_type,_predicate>
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  CSFlatSortedRegistry::CFlatSortedRegistry   ()
+ {
+     m_dead_count            = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::STORAGE::iterator CSFlatSortedRegistry::lower_bound(const _key_type &key)
+ {
+     return                  (std::lower_bound(m_storage.begin(),m_storage.end(),key,CKeyPredicate()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::iterator CSFlatSortedRegistry::begin ()
+ {
+     return                  (iterator(m_storage.begin(),m_storage.end()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::iterator CSFlatSortedRegistry::end   ()
+ {
+     return                  (iterator(m_storage.end(),m_storage.end()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::const_iterator CSFlatSortedRegistry::begin   () const
+ {
+     return                  (const_iterator(m_storage.begin(),m_storage.end()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::const_iterator CSFlatSortedRegistry::end     () const
+ {
+     return                  (const_iterator(m_storage.end(),m_storage.end()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::iterator CSFlatSortedRegistry::find  (const _key_type &key)
+ {
+     typename STORAGE::iterator  I = lower_bound(key);
+     if ((I == m_storage.end()) || _predicate()(key,(*I).first) || !(*I).second)
+         return              (end());
+     return                  (iterator(I,m_storage.end()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::const_iterator CSFlatSortedRegistry::find    (const _key_type &key) const
+ {
+     return                  (const_iterator(const_cast<CSFlatSortedRegistry*>(this)->find(key)));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  std::pair<typename CSFlatSortedRegistry::iterator,bool> CSFlatSortedRegistry::insert(const value_type &value)
+ {
+     VERIFY                  (value.second);
+     typename STORAGE::iterator  I = lower_bound(value.first);
+     if ((I != m_storage.end()) && !_predicate()(value.first,(*I).first)) {
+         if ((*I).second)
+             return          (std::make_pair(iterator(I,m_storage.end()),false));
+ 
+         // revive the tombstone in place
+         (*I).second         = value.second;
+         --m_dead_count;
+         return              (std::make_pair(iterator(I,m_storage.end()),true));
+     }
+ 
+     I                       = m_storage.insert(I,value);
+     return                  (std::make_pair(iterator(I,m_storage.end()),true));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSFlatSortedRegistry::erase            (iterator I)
+ {
+     VERIFY                  ((I != end()) && (*I).second);
+     (*I.base()).second      = 0;
+     ++m_dead_count;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSFlatSortedRegistry::clear            ()
+ {
+     m_storage.clear         ();
+     m_dead_count            = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CSFlatSortedRegistry::size              () const
+ {
+     return                  (u32(m_storage.size()) - m_dead_count);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CSFlatSortedRegistry::empty            () const
+ {
+     return                  (!size());
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CSFlatSortedRegistry::fragmented       () const
+ {
+     return                  ((m_dead_count > 16) && ((m_dead_count << 2) > m_storage.size()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSFlatSortedRegistry::compact          ()
+ {
+     u32                     j = 0;
+     for (u32 i=0, n=u32(m_storage.size()); i<n; ++i)
+         if (m_storage[i].second)
+             m_storage[j++]  = m_storage[i];
+     m_storage.resize        (j);
+     m_dead_count            = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CSFlatSortedRegistry::position          (const_iterator I) const
+ {
+     return                  (u32(I.base() - m_storage.begin()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSFlatSortedRegistry::iterator CSFlatSortedRegistry::at    (u32 position)
+ {
+     if (position >= m_storage.size())
+         return              (end());
+     return                  (iterator(m_storage.begin() + position,m_storage.end()));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  u32 CSFlatSortedRegistry::capacity          () const
+ {
+     return                  (u32(m_storage.size()));
+ }
+ 
+ #undef TEMPLATE_SPECIALIZATION
+ #undef CSFlatSortedRegistry
+ 
+ #define TEMPLATE_SPECIALIZATION \
+     template <\
+         typename _key_type,\
+         typename _data_type,\
+         typename _predicate,\
+         typename _cycle_type,\
+         bool     use_first_update\
+     >
+ 
+ #define CSSafeFlatMapIterator   CSafeFlatMapIterator<_key_type,_data_type,_predicate,_cycle_type,use_first_update>
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  CSSafeFlatMapIterator::CSafeFlatMapIterator ()
+ {
+     m_cycle_count           = _cycle_type(-1);
+     m_first_update          = use_first_update;
+     m_start_time            = 0;
+     m_max_process_time      = 0;
+     m_next_position         = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ CSSafeFlatMapIterator::~CSafeFlatMapIterator    ()
+ {
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::add             (const _key_type &id, _data_type *value, bool no_assert)
+ {
+     u32                     capacity = m_objects.capacity();
+     std::pair<_iterator,bool>   result = m_objects.insert(std::make_pair(id,value));
+     if (!result.second) {
+         R_ASSERT2           (no_assert,"Specified object has been already found in the registry!");
+         return;
+     }
+ 
+     // a new cell shifts the tail, keep pointing to the same next object
+     if ((m_objects.capacity() != capacity) && (m_objects.position(result.first) <= m_next_position))
+         ++m_next_position;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::remove          (const _key_type &id, bool no_assert)
+ {
+     _iterator               I = m_objects.find(id);
+     if (I == m_objects.end()) {
+         R_ASSERT2           (no_assert,"Specified object hasn't been found in the registry!");
+         return;
+     }
+ 
+     // tombstone, the next object is found by skipping it
+     m_objects.erase         (I);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  typename CSSafeFlatMapIterator::_iterator CSSafeFlatMapIterator::next   ()
+ {
+     _iterator               I = m_objects.at(m_next_position);
+     if (I == m_objects.end())
+         I                   = m_objects.begin();
+     m_next_position         = m_objects.position(I);
+     return                  (I);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::update_next     ()
+ {
+     if (m_objects.empty()) {
+         m_next_position     = 0;
+         return;
+     }
+ 
+     next                    ();
+     ++m_next_position;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::start_timer     ()
+ {
+     m_start_time            = CPU::GetCycleCount();
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CSSafeFlatMapIterator::time_over       ()
+ {
+     return                  (!m_first_update && (CPU::GetCycleCount() >= (m_start_time + m_max_process_time)));
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::set_process_time(const u64 &process_time)
+ {
+     m_max_process_time      = process_time;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  const typename CSSafeFlatMapIterator::_REGISTRY &CSSafeFlatMapIterator::objects () const
+ {
+     return                  (m_objects);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ template <typename _update_predicate>
+ IC  u32 CSSafeFlatMapIterator::update           (const _update_predicate &predicate)
+ {
+     if (empty())
+         return              (0);
+ 
+     // deferred compaction, between the time slices only
+     if (m_objects.fragmented()) {
+         _key_type           key = (*next()).first;
+         m_objects.compact   ();
+         m_next_position     = m_objects.position(m_objects.find(key));
+     }
+ 
+     start_timer             ();
+     m_cycle_count           = m_start_time;
+     _iterator               I = next();
+     VERIFY                  (I != m_objects.end());
+     for (u32 i=0; (I != m_objects.end()) && !time_over() && predicate(I,m_cycle_count,true); ++i) {
+         update_next         ();
+         predicate           (I,m_cycle_count);
+         if (empty())
+             break;
+         I                   = next();
+     }
+     m_first_update          = false;
+     return                  (i);
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::clear           ()
+ {
+     m_objects.clear         ();
+     m_next_position         = 0;
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  bool CSSafeFlatMapIterator::empty           () const
+ {
+     return                  (objects().empty());
+ }
+ 
+ TEMPLATE_SPECIALIZATION
+ IC  void CSSafeFlatMapIterator::begin           ()
+ {
+     m_next_position         = 0;
+     m_first_update          = true;
+ }
+ 
+ #undef TEMPLATE_SPECIALIZATION
+ #undef CSSafeFlatMapIterator
+
+
+
+
@@ -0,0 +1,181 @@
+ //  Module      : slot_id_map.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Map over 16-bit ids with slot array lookup
+ 
+ #pragma once
+ 
+ // Every id owns a slot holding its value, so lookup is a single index. A bit mask of the live
+ // slots lets iteration skip 32 free ids at a time, values are visited in id order as with xr_map.
+ // Iterators are slot indices: erase(iterator) returns the next one and invalidates nothing else,
+ // so 'erase(I++)' loops keep working. The slot vector is reserved for every id at construction,
+ // insert never reallocates and references to the values stay valid as well.
+ // Slots count removals in a generation, a handle (generation << 16 | id) kept over
+ // a remove-and-reuse of the id is detected as stale. Ids are still allocated by CID_Generator.
+ 
+ template <
+     typename _key_type,
+     typename _data_type
+ >
+ class CSlotIdMap {
+ public:
+     typedef std::pair<_key_type,_data_type>            value_type;
+ 
+ protected:
+     enum {
+         SLOT_COUNT                    = 0x10000,
+     };
+ 
+     struct CSlot {
+         value_type                    m_value;
+         u16                            m_generation;
+ 
+         IC                            CSlot            () : m_value(_key_type(0),_data_type()), m_generation(0) {}
+     };
+ 
+     template <typename _map_type, typename _value_type>
+     class CIterator {
+     public:
+         _map_type                    *m_map;
+         u32                            m_index;
+ 
+     public:
+         IC                            CIterator        () : m_map(0), m_index(0) {}
+         IC                            CIterator        (_map_type *map, u32 index) : m_map(map), m_index(index) {}
+         template <typename _other_map_type, typename _other_value_type>
+         IC                            CIterator        (const CIterator<_other_map_type,_other_value_type> &I) : m_map(I.m_map), m_index(I.m_index) {}
+         IC        _value_type            &operator*        () const    { return (m_map->m_slots[m_index].m_value);    }
+         IC        _value_type            *operator->        () const    { return (&m_map->m_slots[m_index].m_value);    }
+         IC        CIterator            &operator++        ()            { m_index = m_map->next(m_index + 1); return (*this); }
+         IC        CIterator            operator++        (int)        { CIterator temp = *this; ++*this; return (temp); }
+         IC        bool                operator==        (const CIterator &I) const    { return (m_index == I.m_index);    }
+         IC        bool                operator!=        (const CIterator &I) const    { return (m_index != I.m_index);    }
+     };
+ 
+ public:
+     typedef CIterator<CSlotIdMap,value_type>                iterator;
+     typedef CIterator<const CSlotIdMap,const value_type>    const_iterator;
+ 
+ protected:
+     xr_vector<CSlot>                m_slots;        // grown up to the largest id seen
+     xr_vector<u32>                    m_live;            // a bit per slot
+     u32                                m_count;
+ 
+ protected:
+     IC        bool                    live            (u32 index) const
+     {
+         return                        (!!(m_live[index >> 5] & (u32(1) << (index & 31))));
+     }
+ 
+     // the first live slot starting from index, m_slots.size() if there is none
+     IC        u32                        next            (u32 index) const
+     {
+         u32                            count = u32(m_slots.size());
+         while (index < count) {
+             u32                        mask = m_live[index >> 5] >> (index & 31);
+             if (!mask) {
+                 index                = (index | 31) + 1;
+                 continue;
+             }
+             for ( ; !(mask & 1); mask >>= 1, ++index);
+             return                    (index);
+         }
+         return                        (count);
+     }
+ 
+ public:
+     IC                                CSlotIdMap        ()
+     {
+         m_slots.reserve                (SLOT_COUNT);
+         m_live.assign                (SLOT_COUNT >> 5,0);
+         m_count                        = 0;
+     }
+ 
+     IC        iterator                begin            ()            { return (iterator(this,next(0)));                        }
+     IC        iterator                end                ()            { return (iterator(this,u32(m_slots.size())));            }
+     IC        const_iterator            begin            () const    { return (const_iterator(this,next(0)));                }
+     IC        const_iterator            end                () const    { return (const_iterator(this,u32(m_slots.size())));    }
+     IC        bool                    empty            () const    { return (!m_count);                                    }
+     IC        u32                        size            () const    { return (m_count);                                        }
+ 
+     IC        iterator                find            (const _key_type &key)
+     {
+         VERIFY                        (u32(key) < SLOT_COUNT);
+         return                        (((u32(key) < m_slots.size()) && live(u32(key))) ? iterator(this,u32(key)) : end());
+     }
+ 
+     IC        const_iterator            find            (const _key_type &key) const
+     {
+         VERIFY                        (u32(key) < SLOT_COUNT);
+         return                        (((u32(key) < m_slots.size()) && live(u32(key))) ? const_iterator(this,u32(key)) : end());
+     }
+ 
+     IC        std::pair<iterator,bool>insert            (const value_type &value)
+     {
+         u32                            key = u32(value.first);
+         VERIFY                        (key < SLOT_COUNT);
+         if (key >= m_slots.size()) {
+             VERIFY2                    (key < m_slots.capacity(),"Slot id map would reallocate and invalidate its values");
+             m_slots.resize            (key + 1);
+         }
+ 
+         if (live(key))
+             return                    (std::make_pair(iterator(this,key),false));
+ 
+         m_slots[key].m_value        = value;
+         m_live[key >> 5]            |= u32(1) << (key & 31);
+         ++m_count;
+         return                        (std::make_pair(iterator(this,key),true));
+     }
+ 
+     IC        _data_type                &operator[]        (const _key_type &key)
+     {
+         return                        ((*insert(value_type(key,_data_type())).first).second);
+     }
+ 
+     IC        iterator                erase            (iterator I)
+     {
+         VERIFY                        ((I.m_map == this) && (I.m_index < m_slots.size()) && live(I.m_index));
+         CSlot                        &slot = m_slots[I.m_index];
+         slot.m_value.second            = _data_type();
+         ++slot.m_generation;
+         m_live[I.m_index >> 5]        &= ~(u32(1) << (I.m_index & 31));
+         --m_count;
+         return                        (iterator(this,next(I.m_index + 1)));
+     }
+ 
+     IC        size_t                    erase            (const _key_type &key)
+     {
+         iterator                    I = find(key);
+         if (I == end())
+             return                    (0);
+         erase                        (I);
+         return                        (1);
+     }
+ 
+     IC        void                    clear            ()
+     {
+         // generations survive, handles taken before clear stay stale
+         for (iterator I = begin(), E = end(); I != E; )
+             I                        = erase(I);
+     }
+ 
+     IC        u32                        handle            (const _key_type &key) const
+     {
+         VERIFY                        (find(key) != end());
+         return                        ((u32(m_slots[u32(key)].m_generation) << 16) | u32(key));
+     }
+ 
+     IC        iterator                find_handle        (u32 handle)
+     {
+         u32                            key = handle & 0xffff;
+         iterator                    I = find(_key_type(key));
+         if ((I == end()) || (m_slots[key].m_generation != u16(handle >> 16)))
+             return                    (end());
+         return                        (I);
+     }
+ };
+
+
+
+
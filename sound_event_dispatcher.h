@@ -0,0 +1,69 @@
+ //  Module      : sound_event_dispatcher.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Spatial hash sound event dispatcher
+ 
+ #pragma once
+ 
+ #include "../feel_sound.h"
+ 
+ // Listeners are stored in every cell of a 2D (xz) hash their hearing radius covers,
+ // so a sound event looks up the single cell of its source and checks only the listeners there.
+ // Per-type power thresholds are kept in a table indexed by the type bit,
+ // an event is delivered if its power, attenuated by distance, reaches the threshold.
+ 
+ class CSoundEventDispatcher {
+ public:
+     enum {
+         TYPE_BIT_COUNT  = 32,
+     };
+ 
+     struct CListener {
+         Feel::Sound                 *m_listener;
+         Fvector                     m_position;
+         float                       m_radius;
+         u32                         m_type_mask;    // sound types the listener reacts to
+         int                         m_min_x, m_min_z, m_max_x, m_max_z;
+         bool                        m_enabled;
+     };
+ 
+     typedef xr_vector<u16>          CELL;
+     typedef xr_vector<CELL>         CELLS;
+     typedef xr_vector<CListener>    LISTENERS;
+ 
+ private:
+     CELLS                           m_cells;
+     LISTENERS                       m_listeners;
+     xr_vector<u16>                  m_free;
+     float                           m_cell_size;
+     float                           m_thresholds    [TYPE_BIT_COUNT];
+ 
+ public:
+     u32                             m_stat_events;
+     u32                             m_stat_checks;
+     u32                             m_stat_deliveries;
+ 
+ protected:
+     IC      u32                     cell_id             (int x, int z) const;
+     IC      int                     cell_coord          (float value) const;
+     IC      void                    insert_cells        (u16 id);
+     IC      void                    remove_cells        (u16 id);
+     IC      float                   threshold           (u32 sound_type) const;
+ 
+ public:
+     IC                              CSoundEventDispatcher(float cell_size = 16.f, u32 cell_count = 4096);
+     IC      void                    set_type_threshold  (u32 sound_type_bit, float threshold);
+     IC      u16                     add                 (Feel::Sound *listener, const Fvector &position, float radius, u32 type_mask);
+     IC      void                    remove              (u16 id);
+     IC      void                    move                (u16 id, const Fvector &position);
+     IC      void                    set_radius          (u16 id, float radius);
+     IC      void                    enable              (u16 id, bool value);
+     IC      void                    dispatch            (CObject *who, u32 sound_type, const Fvector &position, float power);
+     IC      const CListener         &listener           (u16 id) const;
+ };
+ 
+ #include "sound_event_dispatcher_inline.h"
+
+
+
+
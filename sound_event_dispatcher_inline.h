@@ -0,0 +1,168 @@
+ //  Module      : sound_event_dispatcher_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Spatial hash sound event dispatcher inline functions
+ 
+ #pragma once
+ 
+ IC  CSoundEventDispatcher::CSoundEventDispatcher(float cell_size, u32 cell_count)
+ {
+     VERIFY                  (cell_count && !(cell_count & (cell_count - 1)));
+     m_cell_size             = cell_size;
+     m_cells.resize          (cell_count);
+     for (u32 i=0; i<TYPE_BIT_COUNT; ++i)
+         m_thresholds[i]     = 0.f;
+     m_stat_events           = 0;
+     m_stat_checks           = 0;
+     m_stat_deliveries       = 0;
+ }
+ 
+ IC  u32 CSoundEventDispatcher::cell_id          (int x, int z) const
+ {
+     return                  ((u32(x)*73856093 ^ u32(z)*19349663) & (u32(m_cells.size()) - 1));
+ }
+ 
+ IC  int CSoundEventDispatcher::cell_coord       (float value) const
+ {
+     return                  (iFloor(value/m_cell_size));
+ }
+ 
+ IC  void CSoundEventDispatcher::insert_cells    (u16 id)
+ {
+     CListener               &listener = m_listeners[id];
+     listener.m_min_x        = cell_coord(listener.m_position.x - listener.m_radius);
+     listener.m_max_x        = cell_coord(listener.m_position.x + listener.m_radius);
+     listener.m_min_z        = cell_coord(listener.m_position.z - listener.m_radius);
+     listener.m_max_z        = cell_coord(listener.m_position.z + listener.m_radius);
+     for (int x=listener.m_min_x; x<=listener.m_max_x; ++x)
+         for (int z=listener.m_min_z; z<=listener.m_max_z; ++z) {
+             CELL            &cell = m_cells[cell_id(x,z)];
+             if (std::find(cell.begin(),cell.end(),id) == cell.end())
+                 cell.push_back(id);
+         }
+ }
+ 
+ IC  void CSoundEventDispatcher::remove_cells    (u16 id)
+ {
+     CListener               &listener = m_listeners[id];
+     for (int x=listener.m_min_x; x<=listener.m_max_x; ++x)
+         for (int z=listener.m_min_z; z<=listener.m_max_z; ++z) {
+             CELL            &cell = m_cells[cell_id(x,z)];
+             CELL::iterator  I = std::find(cell.begin(),cell.end(),id);
+             if (I != cell.end()) {
+                 *I          = cell.back();
+                 cell.pop_back();
+             }
+         }
+ }
+ 
+ IC  float CSoundEventDispatcher::threshold      (u32 sound_type) const
+ {
+     // the lowest threshold among the type bits of the sound
+     float                   result = flt_max;
+     for (u32 i=0; sound_type && (i<TYPE_BIT_COUNT); ++i, sound_type >>= 1)
+         if (sound_type & 1)
+             result          = _min(result,m_thresholds[i]);
+     return                  (result == flt_max ? 0.f : result);
+ }
+ 
+ IC  void CSoundEventDispatcher::set_type_threshold  (u32 sound_type_bit, float threshold)
+ {
+     VERIFY                  (sound_type_bit < TYPE_BIT_COUNT);
+     m_thresholds[sound_type_bit]    = threshold;
+ }
+ 
+ IC  u16 CSoundEventDispatcher::add              (Feel::Sound *listener, const Fvector &position, float radius, u32 type_mask)
+ {
+     u16                     id;
+     if (!m_free.empty()) {
+         id                  = m_free.back();
+         m_free.pop_back     ();
+     }
+     else {
+         VERIFY              (m_listeners.size() < u16(-1));
+         id                  = u16(m_listeners.size());
+         m_listeners.push_back(CListener());
+     }
+ 
+     CListener               &object = m_listeners[id];
+     object.m_listener       = listener;
+     object.m_position       = position;
+     object.m_radius         = radius;
+     object.m_type_mask      = type_mask;
+     object.m_enabled        = true;
+     insert_cells            (id);
+     return                  (id);
+ }
+ 
+ IC  void CSoundEventDispatcher::remove          (u16 id)
+ {
+     VERIFY                  (m_listeners[id].m_listener);
+     remove_cells            (id);
+     m_listeners[id].m_listener  = 0;
+     m_free.push_back        (id);
+ }
+ 
+ IC  void CSoundEventDispatcher::move            (u16 id, const Fvector &position)
+ {
+     CListener               &listener = m_listeners[id];
+     listener.m_position     = position;
+     if ((cell_coord(position.x - listener.m_radius) == listener.m_min_x) &&
+         (cell_coord(position.x + listener.m_radius) == listener.m_max_x) &&
+         (cell_coord(position.z - listener.m_radius) == listener.m_min_z) &&
+         (cell_coord(position.z + listener.m_radius) == listener.m_max_z))
+         return;
+ 
+     remove_cells            (id);
+     insert_cells            (id);
+ }
+ 
+ IC  void CSoundEventDispatcher::set_radius      (u16 id, float radius)
+ {
+     remove_cells            (id);
+     m_listeners[id].m_radius    = radius;
+     insert_cells            (id);
+ }
+ 
+ IC  void CSoundEventDispatcher::enable          (u16 id, bool value)
+ {
+     m_listeners[id].m_enabled   = value;
+ }
+ 
+ IC  void CSoundEventDispatcher::dispatch        (CObject *who, u32 sound_type, const Fvector &position, float power)
+ {
+     ++m_stat_events;
+     float                   min_power = threshold(sound_type);
+     if (power < min_power)
+         return;
+ 
+     const CELL              &cell = m_cells[cell_id(cell_coord(position.x),cell_coord(position.z))];
+     CELL::const_iterator    I = cell.begin();
+     CELL::const_iterator    E = cell.end();
+     for ( ; I != E; ++I) {
+         const CListener     &listener = m_listeners[*I];
+         ++m_stat_checks;
+         if (!listener.m_enabled || !(listener.m_type_mask & sound_type))
+             continue;
+ 
+         float               distance_sqr = listener.m_position.distance_to_sqr(position);
+         if (distance_sqr > _sqr(listener.m_radius))
+             continue;
+ 
+         // linear attenuation over the hearing radius
+         if (power*(1.f - _sqrt(distance_sqr)/listener.m_radius) < min_power)
+             continue;
+ 
+         ++m_stat_deliveries;
+         listener.m_listener->feel_sound_new(who,int(sound_type),position,power);
+     }
+ }
+ 
+ IC  const CSoundEventDispatcher::CListener &CSoundEventDispatcher::listener (u16 id) const
+ {
+     return                  (m_listeners[id]);
+ }
+
+
+
+
@@ -10,6 +10,7 @@
  #include "../feel_sound.h"
  #include "memory_space_impl.h"
  #include "entity_alive.h"
+ #include "sound_event_dispatcher.h"
  
  class CCustomMonster;
  
@@ -34,6 +35,9 @@
      // to minimize dynamic_casts
      CCustomMonster                              *m_object;
  
+     // registration in the sound event dispatcher, u16(-1) - not registered
+     u16                                         m_dispatcher_id;
+ 
  private:
      IC      void    update_sound_threshold      ();
      IC      u32     get_priority                (const MemorySpace::CSoundObject &sound) const;
@@ -57,6 +61,9 @@
      IC      void    enable                      (const CObject *object, bool enable);
      IC      void    set_threshold               (float threshold);
      IC      void    restore_threshold           ();
+     IC      void    register_listener           (const Fvector &position, float hearing_radius, u32 sound_type_mask);
+     IC      void    unregister_listener         ();
+     IC      void    update_listener             (const Fvector &position);
  };
  
  #include "sound_memory_manager_inline.h"
@@ -7,6 +7,8 @@
  
  #pragma once
  
+ #include "ai_space.h"
+ 
  IC  void CSoundMemoryManager::update_sound_threshold            ()
  {
      VERIFY      (!fis_zero(m_decrease_factor));
@@ -73,6 +75,26 @@
  {
      m_sound_threshold   = m_min_sound_threshold;
  }
+ 
+ IC  void CSoundMemoryManager::register_listener (const Fvector &position, float hearing_radius, u32 sound_type_mask)
+ {
+     VERIFY              (u16(-1) == m_dispatcher_id);
+     m_dispatcher_id     = ai().sound_dispatcher().add(this,position,hearing_radius,sound_type_mask);
+ }
+ 
+ IC  void CSoundMemoryManager::unregister_listener   ()
+ {
+     if (u16(-1) == m_dispatcher_id)
+         return;
+     ai().sound_dispatcher().remove(m_dispatcher_id);
+     m_dispatcher_id     = u16(-1);
+ }
+ 
+ IC  void CSoundMemoryManager::update_listener   (const Fvector &position)
+ {
+     if (u16(-1) != m_dispatcher_id)
+         ai().sound_dispatcher().move(m_dispatcher_id,position);
+ }
 
 
 
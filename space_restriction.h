@@ -10,6 +10,7 @@
  #include "restriction_space.h"
  #include "space_restriction_holder.h"
  #include "space_restriction_bridge.h"
+ #include "space_restriction_accessibility.h"
  
  class CSpaceRestrictionManager;
  
@@ -48,6 +49,13 @@
      CBaseRestrictionPtr             m_out_space_restriction;
      CBaseRestrictionPtr             m_in_space_restriction;
      FREE_IN_RESTRICTIONS            m_free_in_restrictions;
+     CAccessibilitySet               m_accessibility;
+     // what m_accessibility is built for
+     CBaseRestrictionPtr             m_accessibility_out;
+     CBaseRestrictionPtr             m_accessibility_in;
+     const CSpaceRestrictionBase     *m_accessibility_out_object;
+     const CSpaceRestrictionBase     *m_accessibility_in_object;
+     u32                             m_accessibility_frame;
  
  private:
      IC      bool                    intersects                  (CBaseRestrictionPtr bridge);
@@ -55,6 +63,10 @@
              CBaseRestrictionPtr     merge                       (CBaseRestrictionPtr bridge, const RESTRICTIONS &temp_restrictions) const;
              void                    merge_in_out_restrictions   ();
              void                    merge_free_in_retrictions   ();
+     IC  static  const CSpaceRestrictionBase *implementation     (CBaseRestrictionPtr bridge);
+     IC      bool                    accessibility_actual        () const;
+     IC      void                    update_accessibility        ();
+     IC      void                    reset_accessibility         ();
  
  protected:
      IC      bool                    initialized                 () const;
@@ -73,6 +85,8 @@
              u32                     accessible_nearest          (const Fvector &position, Fvector &result);
              bool                    accessible                  (const Fvector &position, float radius);
              bool                    accessible                  (u32 level_vertex_id, float radius);
+     IC      bool                    accessible                  (u32 level_vertex_id);
+     IC      bool                    accessibility_rejects       (u32 level_vertex_id, bool out_restriction);
      IC      shared_str                  out_restrictions            () const;
      IC      shared_str                  in_restrictions             () const;
      IC      bool                    applied                     () const;
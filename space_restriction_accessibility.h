@@ -0,0 +1,45 @@
+ //  Module      : space_restriction_accessibility.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Precomputed level vertex accessibility set
+ 
+ #pragma once
+ 
+ // Accessibility of every level vertex for one out/in restriction combination,
+ // computed once and stored either as a bitset or, when the runs are long, as a sorted list of run starts.
+ // The set may be built in slices : 'start' it, then call 'build_step' with a vertex budget until it is 'built'.
+ 
+ class CAccessibilitySet {
+ private:
+     xr_vector<u32>                  m_bits;
+     xr_vector<u32>                  m_runs;         // [start,finish) pairs of accessible vertices, sorted
+     u32                             m_vertex_count;
+     u32                             m_current;      // the next vertex to evaluate while building
+     bool                            m_previous;     // accessibility of the vertex before m_current
+     bool                            m_started;
+     bool                            m_compressed;
+     bool                            m_built;
+ 
+ private:
+     IC      void                    finalize            ();
+ 
+ public:
+     IC                              CAccessibilitySet   ();
+     IC      void                    start               (u32 vertex_count);
+     template <typename _predicate>
+     IC      bool                    build_step          (const _predicate &predicate, u32 max_vertex_count);
+     template <typename _predicate>
+     IC      void                    build               (u32 vertex_count, const _predicate &predicate);
+     IC      bool                    accessible          (u32 level_vertex_id) const;
+     IC      bool                    started             () const;
+     IC      bool                    built               () const;
+     IC      bool                    compressed          () const;
+     IC      u32                     memory_usage        () const;
+     IC      void                    clear               ();
+ };
+ 
+ #include "space_restriction_accessibility_inline.h"
+
+
+
+
@@ -0,0 +1,121 @@
+ //  Module      : space_restriction_accessibility_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Precomputed level vertex accessibility set inline functions
+ 
+ #pragma once
+ 
+ IC  CAccessibilitySet::CAccessibilitySet        ()
+ {
+     m_vertex_count          = 0;
+     m_current               = 0;
+     m_previous              = false;
+     m_started               = false;
+     m_compressed            = false;
+     m_built                 = false;
+ }
+ 
+ IC  void CAccessibilitySet::start               (u32 vertex_count)
+ {
+     clear                   ();
+     m_vertex_count          = vertex_count;
+     m_bits.assign           ((vertex_count + 31) >> 5,0);
+     m_started               = true;
+ }
+ 
+ template <typename _predicate>
+ IC  bool CAccessibilitySet::build_step          (const _predicate &predicate, u32 max_vertex_count)
+ {
+     VERIFY                  (m_started);
+     if (m_built)
+         return              (true);
+ 
+     u32                     finish = m_current + _min(max_vertex_count,m_vertex_count - m_current);
+     for ( ; m_current < finish; ++m_current) {
+         bool                value = predicate(m_current);
+         if (value)
+             m_bits[m_current >> 5]  |= u32(1) << (m_current & 31);
+         if (value != m_previous) {
+             m_runs.push_back(m_current);
+             m_previous      = value;
+         }
+     }
+ 
+     if (m_current < m_vertex_count)
+         return              (false);
+ 
+     finalize                ();
+     return                  (true);
+ }
+ 
+ template <typename _predicate>
+ IC  void CAccessibilitySet::build               (u32 vertex_count, const _predicate &predicate)
+ {
+     start                   (vertex_count);
+     build_step              (predicate,vertex_count);
+ }
+ 
+ IC  void CAccessibilitySet::finalize            ()
+ {
+     if (m_previous)
+         m_runs.push_back    (m_vertex_count);
+ 
+     VERIFY                  (!(m_runs.size() & 1));
+     m_compressed            = (m_runs.size() < m_bits.size());
+     if (m_compressed) {
+         xr_vector<u32>      temp;
+         m_bits.swap         (temp);
+     }
+     else {
+         xr_vector<u32>      temp;
+         m_runs.swap         (temp);
+     }
+     m_built                 = true;
+ }
+ 
+ IC  bool CAccessibilitySet::accessible          (u32 level_vertex_id) const
+ {
+     VERIFY                  (m_built && (level_vertex_id < m_vertex_count));
+     if (!m_compressed)
+         return              (!!(m_bits[level_vertex_id >> 5] & (u32(1) << (level_vertex_id & 31))));
+ 
+     // odd number of run boundaries not greater than the vertex means it is inside a run
+     xr_vector<u32>::const_iterator  I = std::upper_bound(m_runs.begin(),m_runs.end(),level_vertex_id);
+     return                  (!!((I - m_runs.begin()) & 1));
+ }
+ 
+ IC  bool CAccessibilitySet::started             () const
+ {
+     return                  (m_started);
+ }
+ 
+ IC  bool CAccessibilitySet::built               () const
+ {
+     return                  (m_built);
+ }
+ 
+ IC  bool CAccessibilitySet::compressed          () const
+ {
+     return                  (m_compressed);
+ }
+ 
+ IC  u32 CAccessibilitySet::memory_usage         () const
+ {
+     return                  (u32(m_bits.size() + m_runs.size())*sizeof(u32));
+ }
+ 
+ IC  void CAccessibilitySet::clear               ()
+ {
+     m_bits.clear            ();
+     m_runs.clear            ();
+     m_vertex_count          = 0;
+     m_current               = 0;
+     m_previous              = false;
+     m_started               = false;
+     m_compressed            = false;
+     m_built                 = false;
+ }
+
+
+
+
@@ -10,6 +10,7 @@
  #include "restriction_space.h"
  
  class CSpaceRestrictionBase;
+ class CSpaceRestriction;
  
  class CSpaceRestrictionBridge : public RestrictionSpace::CTimeIntrusiveBase {
  protected:
@@ -22,6 +23,7 @@
      IC                              CSpaceRestrictionBridge     (CSpaceRestrictionBase *object);
      virtual                         ~CSpaceRestrictionBridge    ();
              void                    change_implementation       (CSpaceRestrictionBase *object);
+     IC      const CSpaceRestrictionBase *implementation         () const;
              const xr_vector<u32>    &border                     () const;
              bool                    initialized                 () const;
              void                    initialize                  ();
@@ -35,6 +37,9 @@
              bool                    default_restrictor          () const;
              bool                    on_border                   (const Fvector &position) const;
  
+     template <typename T>
+     IC  static  bool                rejected                (T &restriction, u32 level_vertex_id, bool out_restriction);
+     IC  static  bool                rejected                (CSpaceRestriction *restriction, u32 level_vertex_id, bool out_restriction);
      template <typename T>
      IC      bool                    accessible_neighbours   (T &restriction, u32 level_vertex_id, bool out_restriction);
  
@@ -19,6 +19,17 @@
      return      (*m_object);
  }
  
+ IC  const CSpaceRestrictionBase *CSpaceRestrictionBridge::implementation   () const
+ {
+     return      (m_object);
+ }
+ 
+ template <typename T>
+ IC  bool CSpaceRestrictionBridge::rejected              (T &restriction, u32 level_vertex_id, bool out_restriction)
+ {
+     return      (false);
+ }
+ 
  template <typename T>
  IC  bool CSpaceRestrictionBridge::accessible_neighbours (T &restriction, u32 level_vertex_id, bool out_restriction)
  {
@@ -29,6 +40,9 @@
          if (!ai().level_graph().valid_vertex_id(current))
              continue;
  
+         if (rejected(restriction,current,out_restriction))
+             continue;
+ 
          if (restriction->inside(current,!out_restriction) != out_restriction)
              continue;
  
@@ -71,6 +85,8 @@
              //      check if node is completely inside
              // else
              //      check if node is completely outside
+             if (rejected(restriction,current,out_restriction))
+                 continue;
              if (restriction->inside(current,!out_restriction) != out_restriction)
                  continue;
              
@@ -15,6 +15,96 @@
      m_in_restrictions               = in_restrictions;
      m_initialized                   = false;
      m_applied                       = false;
+     m_accessibility_out_object      = 0;
+     m_accessibility_in_object       = 0;
+     m_accessibility_frame           = u32(-1);
+ }
+ 
+ struct CSpaceRestrictionAccessiblePredicate {
+     CSpaceRestriction               *m_restriction;
+ 
+     IC                              CSpaceRestrictionAccessiblePredicate(CSpaceRestriction *restriction) : m_restriction(restriction) {}
+     IC  bool                        operator()                          (u32 level_vertex_id) const
+     {
+         return                      (m_restriction->accessible(level_vertex_id,0.f));
+     }
+ };
+ 
+ IC  const CSpaceRestrictionBase *CSpaceRestriction::implementation  (CBaseRestrictionPtr bridge)
+ {
+     return                          (bridge ? bridge->implementation() : 0);
+ }
+ 
+ IC  bool CSpaceRestriction::accessibility_actual    () const
+ {
+     return                          (
+         (m_accessibility_out == m_out_space_restriction) &&
+         (m_accessibility_in == m_in_space_restriction) &&
+         (m_accessibility_out_object == implementation(m_out_space_restriction)) &&
+         (m_accessibility_in_object == implementation(m_in_space_restriction))
+     );
+ }
+ 
+ IC  void CSpaceRestriction::reset_accessibility     ()
+ {
+     m_accessibility.clear           ();
+     m_accessibility_out             = m_out_space_restriction;
+     m_accessibility_in              = m_in_space_restriction;
+     m_accessibility_out_object      = implementation(m_out_space_restriction);
+     m_accessibility_in_object       = implementation(m_in_space_restriction);
+ }
+ 
+ IC  void CSpaceRestriction::update_accessibility    ()
+ {
+     if (!initialized())
+         return;
+ 
+     // restrictors changed their shapes
+     if (!accessibility_actual())
+         reset_accessibility         ();
+ 
+     if (m_accessibility.built() || (m_accessibility_frame == Device.dwFrame))
+         return;
+ 
+     // one slice per frame, the shapes answer the queries until the set is built
+     m_accessibility_frame           = Device.dwFrame;
+     if (!m_accessibility.started())
+         m_accessibility.start       (ai().level_graph().header().vertex_count());
+     m_accessibility.build_step      (CSpaceRestrictionAccessiblePredicate(this),4096);
+ }
+ 
+ IC  bool CSpaceRestriction::accessible              (u32 level_vertex_id)
+ {
+     update_accessibility            ();
+ 
+     bool                            result = m_accessibility.built() ? m_accessibility.accessible(level_vertex_id) : accessible(level_vertex_id,0.f);
+     if (!result || !m_applied)
+         return                      (result);
+ 
+     // free in restrictions enabled by add_border are not part of the set
+     FREE_IN_RESTRICTIONS::const_iterator   I = m_free_in_restrictions.begin();
+     FREE_IN_RESTRICTIONS::const_iterator   E = m_free_in_restrictions.end();
+     for ( ; I != E; ++I)
+         if ((*I).m_enabled && (*I).m_restriction->inside(level_vertex_id,false))
+             return                  (false);
+ 
+     return                          (true);
+ }
+ 
+ IC  bool CSpaceRestriction::accessibility_rejects   (u32 level_vertex_id, bool out_restriction)
+ {
+     update_accessibility            ();
+     if (!m_accessibility.built())
+         return                      (false);
+ 
+     // an accessible center means the vertex is partially accessible,
+     // an inaccessible one means it is not completely accessible
+     return                          (m_accessibility.accessible(level_vertex_id) != out_restriction);
+ }
+ 
+ IC  bool CSpaceRestrictionBridge::rejected          (CSpaceRestriction *restriction, u32 level_vertex_id, bool out_restriction)
+ {
+     return                          (restriction->accessibility_rejects(level_vertex_id,out_restriction));
  }
  
  IC  const xr_vector<u32> &CSpaceRestriction::border ()
@@ -67,6 +67,7 @@
              void                remove_border                   (ALife::_OBJECT_ID id);
              bool                accessible                      (ALife::_OBJECT_ID id, const Fvector &position, float radius);
              bool                accessible                      (ALife::_OBJECT_ID id, u32 level_vertex_id, float radius);
+     IC      bool                accessible                      (ALife::_OBJECT_ID id, u32 level_vertex_id);
              u32                 accessible_nearest              (ALife::_OBJECT_ID id, const Fvector &position, Fvector &result);
              shared_str              in_restrictions                 (ALife::_OBJECT_ID id);
              shared_str              out_restrictions                (ALife::_OBJECT_ID id);
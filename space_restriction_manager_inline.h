@@ -21,6 +21,15 @@
      if (client_restriction)
          client_restriction->add_border  (p1,p2);
  }
+ 
+ IC  bool CSpaceRestrictionManager::accessible                   (ALife::_OBJECT_ID id, u32 level_vertex_id)
+ {
+     // bit test in the accessibility set of the client's restriction combination (built a slice per frame)
+     CRestrictionPtr                     client_restriction = restriction(id);
+     if (!client_restriction)
+         return                          (true);
+     return                              (client_restriction->accessible(level_vertex_id));
+ }
 
 
 
@@ -0,0 +1,76 @@
+ //  Module      : vision_service.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Batched line-of-sight service for visual memory managers
+ 
+ #pragma once
+ 
+ // All NPC->target line-of-sight checks of a frame are gathered here,
+ // symmetric pairs (A->B, B->A) share one ray, and only the 'ray budget' most important
+ // pairs are traced per frame. Unanswered pairs gain priority every frame they wait,
+ // so no pair starves; until it is traced the previous answer is used.
+ 
+ class CVisionService {
+ public:
+     struct CRequest {
+         u32                         m_key;          // (min_id << 16) | max_id
+         Fvector                     m_start;
+         Fvector                     m_finish;
+         float                       m_priority;
+         u32                         m_age;          // frames spent in the queue
+ 
+         IC  bool                    operator<       (const CRequest &request) const
+         {
+             return                  (m_key < request.m_key);
+         }
+     };
+ 
+     struct CRequestPriorityPredicate {
+         IC  bool                    operator()      (const CRequest &request0, const CRequest &request1) const
+         {
+             return                  ((request0.m_priority + float(request0.m_age)) > (request1.m_priority + float(request1.m_age)));
+         }
+     };
+ 
+     struct CResult {
+         u32                         m_frame;        // frame the ray was traced
+         bool                        m_visible;
+     };
+ 
+ public:
+     typedef xr_vector<CRequest>     REQUESTS;
+     typedef xr_map<u32,CResult>     RESULTS;
+ 
+ private:
+     REQUESTS                        m_requests;     // this frame
+     REQUESTS                        m_pending;      // carried over from previous frames
+     RESULTS                         m_results;
+     u32                             m_ray_budget;
+     u32                             m_frame;
+     u32                             m_result_lifetime;
+ 
+ public:
+     u32                             m_stat_requests;
+     u32                             m_stat_rays;
+ 
+ protected:
+     IC  static u32                  pair_key        (u16 id0, u16 id1);
+     IC      void                    merge_requests  ();
+     IC  static void                 remove          (REQUESTS &requests, u16 object_id);
+ 
+ public:
+     IC                              CVisionService  (u32 ray_budget = 64, u32 result_lifetime = 30);
+     IC      void                    set_ray_budget  (u32 ray_budget);
+     IC      void                    request         (u16 observer_id, u16 target_id, const Fvector &observer_position, const Fvector &target_position, float priority);
+     IC      bool                    visible         (u16 observer_id, u16 target_id, bool &visible) const;
+     template <typename _ray_query>
+     IC      void                    update          (const _ray_query &ray_query);
+     IC      void                    remove          (u16 object_id);
+     IC      void                    clear           ();
+ };
+ 
+ #include "vision_service_inline.h"
+
+
+
+
@@ -0,0 +1,150 @@
+ //  Module      : vision_service_inline.h
+ //  Created     : 19.10.2026
+ //  Modified    : 19.10.2026
+ //  Description : Batched line-of-sight service for visual memory managers inline functions
+ 
+ #pragma once
+ 
+ IC  CVisionService::CVisionService              (u32 ray_budget, u32 result_lifetime)
+ {
+     m_ray_budget            = ray_budget;
+     m_result_lifetime       = result_lifetime;
+     m_frame                 = 0;
+     m_stat_requests         = 0;
+     m_stat_rays             = 0;
+ }
+ 
+ IC  u32 CVisionService::pair_key                (u16 id0, u16 id1)
+ {
+     return                  ((u32(_min(id0,id1)) << 16) | u32(_max(id0,id1)));
+ }
+ 
+ IC  void CVisionService::set_ray_budget         (u32 ray_budget)
+ {
+     m_ray_budget            = ray_budget;
+ }
+ 
+ IC  void CVisionService::request                (u16 observer_id, u16 target_id, const Fvector &observer_position, const Fvector &target_position, float priority)
+ {
+     VERIFY                  (observer_id != target_id);
+     m_requests.push_back    (CRequest());
+     CRequest                &request = m_requests.back();
+     request.m_key           = pair_key(observer_id,target_id);
+     request.m_start         = observer_position;
+     request.m_finish        = target_position;
+     request.m_priority      = priority;
+     request.m_age           = 0;
+ }
+ 
+ IC  bool CVisionService::visible                (u16 observer_id, u16 target_id, bool &visible) const
+ {
+     RESULTS::const_iterator I = m_results.find(pair_key(observer_id,target_id));
+     if (I == m_results.end())
+         return              (false);
+ 
+     visible                 = (*I).second.m_visible;
+     return                  (true);
+ }
+ 
+ IC  void CVisionService::merge_requests         ()
+ {
+     // the same pair requested by both NPCs (or several times) becomes a single request with the highest priority,
+     // requests still pending from previous frames keep their age
+     m_requests.insert       (m_requests.end(),m_pending.begin(),m_pending.end());
+     m_pending.clear         ();
+     std::stable_sort        (m_requests.begin(),m_requests.end());
+ 
+     if (m_requests.empty())
+         return;
+ 
+     REQUESTS::iterator      I = m_requests.begin();
+     REQUESTS::iterator      E = m_requests.end();
+     REQUESTS::iterator      J = I;
+     for (++I; I != E; ++I) {
+         if ((*J).m_key == (*I).m_key) {
+             (*J).m_priority = _max((*J).m_priority,(*I).m_priority);
+             (*J).m_age      = _max((*J).m_age,(*I).m_age);
+             continue;
+         }
+         *(++J)              = *I;
+     }
+     m_requests.erase        (J + 1,m_requests.end());
+ }
+ 
+ template <typename _ray_query>
+ IC  void CVisionService::update                 (const _ray_query &ray_query)
+ {
+     ++m_frame;
+     m_stat_requests         = u32(m_requests.size());
+     m_stat_rays             = 0;
+ 
+     merge_requests          ();
+ 
+     u32                     ray_count = _min(m_ray_budget,u32(m_requests.size()));
+     std::partial_sort       (m_requests.begin(),m_requests.begin() + ray_count,m_requests.end(),CRequestPriorityPredicate());
+ 
+     REQUESTS::iterator      I = m_requests.begin();
+     REQUESTS::iterator      E = m_requests.end();
+     for (u32 i=0; I != E; ++I, ++i) {
+         if (i < ray_count) {
+             CResult         &result = m_results[(*I).m_key];
+             result.m_frame  = m_frame;
+             result.m_visible= ray_query((*I).m_start,(*I).m_finish);
+             ++m_stat_rays;
+             continue;
+         }
+ 
+         ++(*I).m_age;
+         m_pending.push_back (*I);
+     }
+     m_requests.clear        ();
+ 
+     // forget answers nobody asked for since a while
+     RESULTS::iterator       J = m_results.begin();
+     RESULTS::iterator       EJ = m_results.end();
+     while (J != EJ) {
+         if (m_frame - (*J).second.m_frame > m_result_lifetime)
+             m_results.erase (J++);
+         else
+             ++J;
+     }
+ }
+ 
+ IC  void CVisionService::remove                 (REQUESTS &requests, u16 object_id)
+ {
+     REQUESTS::iterator      I = requests.begin();
+     REQUESTS::iterator      E = requests.end();
+     REQUESTS::iterator      J = I;
+     for ( ; I != E; ++I) {
+         if ((u16((*I).m_key >> 16) == object_id) || (u16((*I).m_key & 0xffff) == object_id))
+             continue;
+         *J++                = *I;
+     }
+     requests.erase          (J,E);
+ }
+ 
+ IC  void CVisionService::remove                 (u16 object_id)
+ {
+     remove                  (m_requests,object_id);
+     remove                  (m_pending,object_id);
+ 
+     RESULTS::iterator       I = m_results.begin();
+     RESULTS::iterator       E = m_results.end();
+     while (I != E) {
+         if ((u16((*I).first >> 16) == object_id) || (u16((*I).first & 0xffff) == object_id))
+             m_results.erase (I++);
+         else
+             ++I;
+     }
+ }
+ 
+ IC  void CVisionService::clear                  ()
+ {
+     m_requests.clear        ();
+     m_pending.clear         ();
+     m_results.clear         ();
+ }
+
+
+
+
@@ -9,6 +9,7 @@
  
  #include "../feel_vision.h"
  #include "memory_space_impl.h"
+ #include "vision_service.h"
  
  class CVisualMemory : public Feel::Vision {
  protected:
@@ -99,6 +100,7 @@
      IC      const u32 visible_object_time_last_seen(const CObject *object) const;
              bool    visible                         (const CGameObject *game_object, float time_delta);
              bool    visible                         (u32 level_vertex_id, float yaw, float eye_fov) const;
+     IC      bool    visible_batched                 (const CGameObject *game_object, const Fvector &eye_position, float priority, bool &visible) const;
      IC      void    set_squad_objects               (xr_vector<CVisibleObject> *squad_objects);
      IC      bool    visible_now                     (const CGameObject *game_object) const;
      IC      void    enable                          (const CObject *object, bool enable);
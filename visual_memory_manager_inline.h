@@ -7,6 +7,8 @@
  
  #pragma once
  
+ #include "ai_space.h"
+ 
  IC  const xr_vector<CVisibleObject> &CVisualMemoryManager::memory_visible_objects() const
  {
      return                          (*m_objects);
@@ -71,6 +73,14 @@
  {
      m_enabled                       = value;
  }
+ 
+ IC  bool CVisualMemoryManager::visible_batched  (const CGameObject *game_object, const Fvector &eye_position, float priority, bool &visible) const
+ {
+     // the ray is traced by the vision service later in the frame, returns false if there is no answer for the pair yet
+     CVisionService                  &service = ai().vision_service();
+     service.request                 (u16(ID()),u16(game_object->ID()),eye_position,game_object->Position(),priority);
+     return                          (service.visible(u16(ID()),u16(game_object->ID()),visible));
+ }
 
 
 
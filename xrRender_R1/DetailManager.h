@@ -8,6 +8,7 @@
  #include "xrpool.h"
  #include "detailformat.h"
  #include "detailmodel.h"
+ #include "R_Instancing.h"
  
  #ifdef _EDITOR
      const int   dm_max_decompress   = 14;
@@ -121,6 +122,17 @@
      void                            hw_Render       ();
      void                            hw_Render_dump  (R_constant* array, u32 var_id, u32 lod_id, u32 c_base);
  
+     // Hardware instancing processor (no constant-array batch limit)
+     // hwi_* are not defined yet, so the processor stays off; enable it with
+     // HW.Caps.geometry_major >= 3 once they are
+     IC bool                         UseInstancing   ()      { return false; }
+     R_InstanceBatcher_D3D           hwi_Batcher;
+     xr_vector<ref_geom>             hwi_Geom;       // per-object geometry with instanced declaration
+     void                            hwi_Load        ();
+     void                            hwi_Unload      ();
+     void                            hwi_Render      ();
+     void                            hwi_Render_dump (u32 var_id, u32 lod_id);
+ 
  public:
      DetailSlot&                     QueryDB         (int sx, int sz);
  
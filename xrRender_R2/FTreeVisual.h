@@ -1,5 +1,7 @@
  #pragma once
  
+ #include "R_Instancing.h"
+ 
  class FTreeVisual : public IRender_Visual
  {
  private:
@@ -23,8 +25,30 @@
      _5color                     c_bias;
  public:
      Fmatrix                     xform;
+     ref_geom                    hGeom_instanced;    // declaration with per-instance xform/lighting in stream 1 (NULL if not supported)
+                                                     // Load does not create it yet, so trees render through 'Render'
  public:
      virtual void Render         (float LOD      );                                  // LOD - Level Of Detail  [0.0f - min, 1.0f - max], Ignored
+     IC      BOOL Instance       (R_InstanceBatcher_D3D& B, u32 pass=0)              // FALSE - must be rendered through 'Render'
+     {
+         if (!hGeom_instanced)   return FALSE;
+ 
+         R_instance_key          K;
+         K.element               = &*hShader->E[pass];
+         K.geom                  = &*hGeom_instanced;
+         K.vBase                 = vBase;
+         K.vCount                = vCount;
+         K.iBase                 = iBase;
+         K.dwPrimitives          = dwPrimitives;
+ 
+         R_instance              I;
+         I.set_xform             (xform);
+         I.c_scale.set           (c_scale.rgb.x,c_scale.rgb.y,c_scale.rgb.z,c_scale.hemi);
+         I.c_bias.set            (c_bias.rgb.x, c_bias.rgb.y, c_bias.rgb.z, c_bias.hemi);
+         I.c_sun.set             (c_scale.sun,  c_bias.sun,   0,            0);
+         B.add                   (K,I);
+         return                  TRUE;
+     }
      virtual void Load           (LPCSTR N, IReader *data, u32 dwFlags);
      virtual void Copy           (IRender_Visual *pFrom  );
      virtual void Release        ();
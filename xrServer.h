@@ -7,12 +7,14 @@
  
  #include "game_sv_base.h"
  #include "id_generator.h"
+ #include "slot_id_map.h"
+ #include "xrServer_interest.h"
  class CSE_Abstract;
  
  const u32   NET_Latency     = 50;       // time in (ms)
  
  // t-defs
- typedef xr_map<u16,CSE_Abstract*>   xrS_entities;
+ typedef CSlotIdMap<u16,CSE_Abstract*>   xrS_entities;
  
  class xrClientData  : public IClient
  {
@@ -42,6 +44,7 @@
  private:
      xrS_entities                entities;
      xr_multiset<svs_respawn>    q_respawn;
+     xrInterestManager           interest;
  
      CID_Generator<
          u32,        // time identifier type
@@ -121,6 +124,7 @@
  
      xrClientData*           ID_to_client        (ClientID ID);
      CSE_Abstract*           ID_to_entity        (u16 ID);
+     IC xrInterestManager&   Interest            ()          { return interest; }
  
      // main
      virtual BOOL            Connect             (shared_str& session_name);
@@ -0,0 +1,203 @@
+ #pragma once
+ 
+ // Interest management for the update replication
+ // Every client accumulates a priority per entity: score * dt, where the score grows
+ // with proximity to the client's view point, is multiplied when the entity is in the view
+ // sector and gets a decaying bonus after activity (events, spawn, ownership change).
+ // Each update the entities are ordered by accumulated priority and taken while their
+ // last written sizes fit the client's byte budget; sending resets the priority. So the
+ // update rate of an entity is proportional to its score, and the stream to a client is
+ // bounded by the budget. HasBandwidth is still checked by the caller before each client.
+ // A client without a view point yet scores every entity alike, so its entities are sent
+ // in turns within the same budget.
+ 
+ class xrInterestManager
+ {
+ public:
+     enum    { no_sector = u16(-1) };
+     struct  SRecord
+     {
+         float                   priority;
+         u16                     size;           // bytes of the last written update
+     };
+     struct  SEntityState
+     {
+         u16                     sector;
+         u32                     activity;       // time of the last activity
+     };
+     struct  SClientInterest
+     {
+         IClient*                client;
+         Fvector                 view;
+         u16                     sector;
+         bool                    has_view;
+         xr_vector<SRecord>      records;        // entity id -> record
+     };
+     typedef xr_vector<SClientInterest>  CLIENTS;
+ protected:
+     CLIENTS                     m_clients;
+     xr_vector<SEntityState>     m_entities;     // entity id -> state
+     xr_vector<u16>              m_order;        // scratch for select
+     u32                         m_bytes_per_second;
+     float                       m_distance_scale;
+     float                       m_sector_factor;
+     float                       m_activity_bonus;
+     u32                         m_activity_time;
+     u16                         m_default_size;
+ 
+     struct  priority_pred
+     {
+         const xr_vector<SRecord>*   R;
+         priority_pred           (const xr_vector<SRecord>* _R) : R(_R) {}
+         IC bool                 operator()      (u16 a, u16 b) const    { return (*R)[a].priority > (*R)[b].priority; }
+     };
+ 
+     IC SClientInterest*         find            (IClient* C)
+     {
+         for (CLIENTS::iterator I=m_clients.begin(); I!=m_clients.end(); ++I)
+             if (I->client == C) return &*I;
+         return                  0;
+     }
+     IC SClientInterest&         add             (IClient* C)
+     {
+         m_clients.push_back     (SClientInterest());
+         SClientInterest&        CI  = m_clients.back();
+         CI.client               = C;
+         CI.view.set             (0.f,0.f,0.f);
+         CI.sector               = no_sector;
+         CI.has_view             = false;
+         return                  CI;
+     }
+     IC SEntityState&            entity          (u16 id)
+     {
+         if (id >= m_entities.size())
+         {
+             SEntityState        S;
+             S.sector            = no_sector;
+             S.activity          = 0;
+             m_entities.resize   (id+1,S);
+         }
+         return                  m_entities[id];
+     }
+     IC SRecord&                 record          (SClientInterest& CI, u16 id)
+     {
+         if (id >= CI.records.size())
+         {
+             SRecord             R;
+             R.priority          = 0.f;
+             R.size              = m_default_size;
+             CI.records.resize   (id+1,R);
+         }
+         return                  CI.records[id];
+     }
+ public:
+     xrInterestManager           (u32 bytes_per_second = 8192) :
+         m_bytes_per_second(bytes_per_second), m_distance_scale(50.f), m_sector_factor(2.f),
+         m_activity_bonus(1.f), m_activity_time(3000), m_default_size(32) {}
+ 
+     // configuration
+     IC void                     set_budget      (u32 bytes_per_second)  { m_bytes_per_second = bytes_per_second; }
+     IC void                     set_scoring     (float distance_scale, float sector_factor, float activity_bonus, u32 activity_time)
+     {
+         VERIFY                  ((distance_scale > 0.f) && activity_time);
+         m_distance_scale        = distance_scale;
+         m_sector_factor         = sector_factor;
+         m_activity_bonus        = activity_bonus;
+         m_activity_time         = activity_time;
+     }
+ 
+     // clients
+     IC void                     client_view     (IClient* C, const Fvector& view, u16 sector = no_sector)
+     {
+         SClientInterest*        CI  = find(C);
+         if (!CI)                CI  = &add(C);
+         CI->view.set            (view);
+         CI->sector              = sector;
+         CI->has_view            = true;
+     }
+     IC void                     client_remove   (IClient* C)
+     {
+         for (CLIENTS::iterator I=m_clients.begin(); I!=m_clients.end(); ++I)
+             if (I->client == C) { m_clients.erase(I); return; }
+     }
+ 
+     // entities
+     IC void                     entity_sector   (u16 id, u16 sector)    { entity(id).sector = sector; }
+     IC void                     entity_activity (u16 id, u32 time)      { entity(id).activity = time; }
+     IC void                     entity_remove   (u16 id)
+     {
+         if (id < m_entities.size())
+         {
+             m_entities[id].sector   = no_sector;
+             m_entities[id].activity = 0;
+         }
+         for (CLIENTS::iterator I=m_clients.begin(); I!=m_clients.end(); ++I)
+             if (id < I->records.size())
+             {
+                 I->records[id].priority = 0.f;
+                 I->records[id].size     = m_default_size;
+             }
+     }
+ 
+     template <typename _entity>
+     IC float                    score           (const SClientInterest& CI, const _entity* E, u32 time)
+     {
+         const SEntityState&     S   = entity(E->ID);
+         float                   s   = 1.f;
+         if (CI.has_view)
+             s                   = m_distance_scale/(m_distance_scale + CI.view.distance_to(E->o_Position));
+         if ((CI.sector != no_sector) && (S.sector == CI.sector))
+             s                   *= m_sector_factor;
+         if (S.activity && (time - S.activity < m_activity_time))
+             s                   += m_activity_bonus*(1.f - float(time - S.activity)/float(m_activity_time));
+         return                  s;
+     }
+ 
+     // ids of the entities to update for the client this frame, most relevant first
+     template <typename _entities>
+     IC void                     select          (IClient* C, const _entities& entities, u32 time, u32 dt, xr_vector<u16>& result)
+     {
+         result.clear            ();
+         SClientInterest*        CI  = find(C);
+         if (!CI)                CI  = &add(C);
+ 
+         float                   seconds = float(dt)/1000.f;
+         m_order.clear           ();
+         for (typename _entities::const_iterator I=entities.begin(); I!=entities.end(); ++I)
+         {
+             typename _entities::value_type::second_type E  = (*I).second;
+             if (!E->net_Ready)  continue;
+             record              (*CI,E->ID).priority    += score(*CI,E,time)*seconds;
+             m_order.push_back   (E->ID);
+         }
+         std::sort               (m_order.begin(),m_order.end(),priority_pred(&CI->records));
+ 
+         u32                     budget  = m_bytes_per_second*dt/1000;
+         u32                     bytes   = 0;
+         for (xr_vector<u16>::const_iterator I=m_order.begin(); I!=m_order.end(); ++I)
+         {
+             u32                 size    = CI->records[*I].size;
+             if (bytes + size > budget)
+             {
+                 // the most relevant entity always goes
+                 if (!result.empty())    break;
+             }
+             bytes               += size;
+             result.push_back    (*I);
+         }
+     }
+ 
+     // the update was written to the client's packet
+     IC void                     sent            (IClient* C, u16 id, u32 size)
+     {
+         SClientInterest*        CI  = find(C);
+         if (!CI)                return;
+         SRecord&                R   = record(*CI,id);
+         R.priority              = 0.f;
+         R.size                  = u16(_min(size,u32(u16(-1))));
+     }
+ };
+
+
+
+
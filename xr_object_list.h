@@ -1,6 +1,8 @@
  #ifndef __XR_OBJECT_LIST_H__
  #define __XR_OBJECT_LIST_H__
  
+ #include "slot_id_map.h"
+ 
  // refs
  class   ENGINE_API  CObject;
  class   ENGINE_API  CInifile;
@@ -10,7 +12,7 @@
  {
  private:
      // data
-     xr_map<u32,CObject*>        map_NETID;
+     CSlotIdMap<u32,CObject*>    map_NETID;
      xr_vector<CObject*>         destroy_queue;
  public:
      xr_vector<CObject*>         objects;